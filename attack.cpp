@@ -430,6 +430,7 @@ EX void killMonster(cell *c, eMonster who, flagtype deathflags IS(0)) {
   DEBBI(DF_TURN, ("killmonster ", dnameof(m)));
   
   if(!m) return;
+  pathcache::invalidate();
   
   if(m == moKrakenH) return;
   if(m == moKrakenT) {
@@ -939,6 +940,8 @@ EX bool notthateasy(eMonster m) {
 
 EX bool attackMonster(cell *c, flagtype flags, eMonster killer) {
 
+  pathcache::invalidate();
+
   if((flags & AF_GETPLAYER) && isPlayerOn(c)) {
     killThePlayerAt(killer, c, flags);
     return true;
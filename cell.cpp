@@ -204,8 +204,119 @@ EX int dirdiff(int dd, int t) {
   return dd;
   }
 
+#if HDR
+/** \brief Slab allocator used by tailored_alloc
+ *
+ *  Each slab holds objects of one size (i.e., cells or heptagons of one degree), allocated
+ *  in the order of creation, so that the cells of a region are close to each other in memory.
+ *  Slabs are aligned to slab_size, so slab_free finds the owner from the address.
+ *
+ *  All the maps of a game share one arena, since maps refer to each other's objects
+ *  (alt maps, underlying maps). clearCellMemory closes the arena: from then on, freeing
+ *  an object is just bookkeeping, and the slabs are released together once the last
+ *  object has been freed.
+ */
+struct slab_arena {
+  static const int slab_size = 1 << 16;
+  struct slab_header {
+    slab_arena *owner;
+    int bytes;
+    };
+  struct size_class {
+    char *next, *end;
+    void *freed;
+    size_class() { next = end = nullptr; freed = nullptr; }
+    };
+  vector<size_class> classes;
+  vector<char*> slabs;
+  int live;
+  bool closed;
+  slab_arena() { live = 0; closed = false; }
+  ~slab_arena();
+  void *alloc(int bytes);
+  void free(void *p);
+  };
+#endif
+
+EX slab_arena *cell_arena;
+
+slab_arena::~slab_arena() {
+  for(char *s: slabs) {
+    #if ISWINDOWS
+    _aligned_free(s);
+    #else
+    ::free(s);
+    #endif
+    }
+  }
+
+void *slab_arena::alloc(int bytes) {
+  bytes = (bytes + 7) & ~7;
+  int id = bytes >> 3;
+  if(id >= isize(classes)) classes.resize(id+1);
+  auto& sc = classes[id];
+  live++;
+  if(sc.freed) {
+    void *res = sc.freed;
+    sc.freed = *(void**) res;
+    return res;
+    }
+  if(!sc.next || sc.next + bytes > sc.end) {
+    char *s;
+    #if ISWINDOWS
+    s = (char*) _aligned_malloc(slab_size, slab_size);
+    #else
+    if(posix_memalign((void**) &s, slab_size, slab_size)) s = nullptr;
+    #endif
+    if(!s) throw std::bad_alloc();
+    slabs.push_back(s);
+    auto h = (slab_header*) s;
+    h->owner = this;
+    h->bytes = bytes;
+    sc.next = s + ((sizeof(slab_header) + 15) & ~15);
+    sc.end = s + slab_size;
+    }
+  void *res = sc.next;
+  sc.next += bytes;
+  return res;
+  }
+
+void slab_arena::free(void *p) {
+  live--;
+  if(closed) {
+    if(!live) delete this;
+    return;
+    }
+  auto h = (slab_header*) (uintptr_t(p) & ~uintptr_t(slab_size - 1));
+  auto& sc = classes[h->bytes >> 3];
+  *(void**) p = sc.freed;
+  sc.freed = p;
+  }
+
+EX void *slab_alloc(int bytes) {
+  if(!cell_arena) cell_arena = new slab_arena;
+  return cell_arena->alloc(bytes);
+  }
+
+EX void slab_free(void *p) {
+  auto h = (slab_arena::slab_header*) (uintptr_t(p) & ~uintptr_t(slab_arena::slab_size - 1));
+  h->owner->free(p);
+  }
+
+/** the objects of the current arena are about to be freed, so do not bother reusing their memory */
+EX void close_cell_arena() {
+  if(!cell_arena) return;
+  auto a = cell_arena;
+  cell_arena = nullptr;
+  a->closed = true;
+  if(!a->live) delete a;
+  }
+
 EX int cellcount = 0;
 
+/** the last serial number given to a cell (see indexed_celllister) */
+EX unsigned last_cell_serial = 0;
+
 EX void destroy_cell(cell *c) {
   tailored_delete(c);
   cellcount--;
@@ -218,6 +329,7 @@ EX cell *newCell(int type, heptagon *master) {
   initcell(c);
   hybrid::will_link(c);
   cellcount++;
+  c->serial = ++last_cell_serial;
   return c;
   }
 
@@ -1299,6 +1411,9 @@ EX void clearCellMemory() {
     return;
     }
   #endif
+  #if CAP_SLAB
+  close_cell_arena();
+  #endif
   for(int i=0; i<isize(allmaps); i++) 
     if(allmaps[i])
       delete allmaps[i];
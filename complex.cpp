@@ -2053,6 +2053,7 @@ EX namespace heat {
   EX vector<cell*> offscreen_heat, offscreen_fire; // offscreen cells to take care off
 
   EX void processheat(double rate IS(1)) {
+    turn_timing::measure tm(turn_timing::ph_heat);
     if(markOrb(itOrbSpeed)) rate /= 2;
     if(racing::on) return;
     int oldmelt = kills[0];    
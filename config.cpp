@@ -737,6 +737,10 @@ EX void initConfig() {
   param_b(vid.want_vsync, "vsync", true)
   ->editable("vsync", 'v');
   #endif
+
+  #if CAP_INSTANCING
+  param_b(glhr::instancing, "gl-instancing", true);
+  #endif
   
   param_b(vid.want_fullscreen, "fullscreen", false)
   ->editable("fullscreen mode", 'f');
@@ -923,10 +927,19 @@ EX void initConfig() {
   param_b(vid.smart_area_based, "smart-area-based", false);
   param_i(vid.cells_drawn_limit, "limit on cells drawn", 10000);
   param_i(vid.cells_generated_limit, "limit on cells generated", 250);
+  param_i(dq::draw_threads, "draw-threads", 1);
+  param_i(inverse_exp_threads, "inverse-exp-threads", 1);
+  #if CAP_HOTCELLS
+  param_b(hot::incremental, "hot-incremental", true);
+  #endif
+  param_b(pathcache::on, "pathcache", true);
+  param_b(pathcache::validate, "pathcache-validate", false);
   
   #if CAP_SOLV
   addsaver(sn::solrange_xy, "solrange-xy");
   addsaver(sn::solrange_z, "solrange-z");
+  param_b(sn::hires_tables, "sol-hires-tables", false)
+  ->set_reaction(sn::reload_tables);
   #endif
   addsaver(slr::steps, "slr-steps");
   addsaver(slr::range_xy, "slr-range-xy");
@@ -3160,6 +3173,11 @@ EX int read_config_args() {
     PHASE(1);
     glhr::noshaders = true; 
     }
+  #if CAP_INSTANCING
+  else if(argis("-instancing")) {
+    PHASEFROM(2); shift(); glhr::instancing = argi();
+    }
+  #endif
   else if(argis("-d:sight")) {
     PHASEFROM(2); launch_dialog(); edit_sightrange();
     }
@@ -858,6 +858,10 @@ int read_cheat_args() {
     PHASEFROM(2); 
     shift(); vid.cells_generated_limit = argi();
     }
+  else if(argis("-draw-threads")) {
+    PHASEFROM(2); 
+    shift(); dq::draw_threads = argi();
+    }
   else if(argis("-sight3")) {
     PHASEFROM(2); 
     shift_arg_formula(sightranges[geometry]);
@@ -931,6 +935,50 @@ int read_cheat_args() {
 auto ah_cheat = addHook(hooks_args, 0, read_cheat_args);
 #endif
 
+/** time spent in the phases of the turn, for benchmarks such as devmods/turn-bench.cpp */
+EX namespace turn_timing {
+
+/** the phases are only timed while this is set */
+EX bool on;
+
+#if HDR
+struct phase {
+  const char *name;
+  double seconds;
+  int calls;
+  bool active;
+  };
+
+/** add the time until the end of the scope to ph; nested (e.g., recursive) measurements of the same phase are ignored */
+struct measure {
+  phase *p;
+  std::chrono::steady_clock::time_point start;
+  measure(phase& ph) : p(on && !ph.active ? &ph : nullptr) {
+    if(!p) return;
+    p->active = true;
+    start = std::chrono::steady_clock::now();
+    }
+  ~measure() {
+    if(!p) return;
+    p->seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    p->calls++;
+    p->active = false;
+    }
+  };
+#endif
+
+EX phase ph_bfs = {"bfs", 0, 0, false};
+EX phase ph_monsters = {"monstersTurn", 0, 0, false};
+EX phase ph_setdist = {"setdist", 0, 0, false};
+EX phase ph_heat = {"heat", 0, 0, false};
+
+EX vector<phase*> phases() { return {&ph_bfs, &ph_monsters, &ph_setdist, &ph_heat}; }
+
+EX void reset() {
+  for(auto p: phases()) p->seconds = 0, p->calls = 0;
+  }
+EX }
+
 EX bool ldebug = false;
 
 EX void breakhere() {
@@ -1,8 +1,13 @@
 // This addon plays HyperRogue by itself.
 // Well, not really -- it performs illegal moves, and it gets tons of treasure, orbs, and kills out of nowhere.
 // Useful for debugging.
+// Many games can be played in parallel with: hyperrogue -nogui -autoplay-farm <workers> <games> <turns per game> <report file>
 
 #include "../hyper.h"
+#include <sys/wait.h>
+#include <unistd.h>
+#include <poll.h>
+#include <signal.h>
 
 namespace hr {
 
@@ -11,6 +16,16 @@ eLand autoplayLand;
 
 namespace prairie { extern cell *enter; }
 
+/** in a worker of the autoplay farm: the pipe to the collector, or -1 */
+int farm_fd = -1;
+
+/** send a line to the collector of the autoplay farm */
+void farm_report(const string& s) {
+  if(farm_fd < 0) return;
+  string line = s + "\n";
+  if(write(farm_fd, line.c_str(), line.size()) < 0) farm_fd = -1;
+  }
+
 bool sameland(eLand ll, eLand ln) {
   if(ln == laBarrier || ln == laOceanWall)
     return true;
@@ -201,10 +216,12 @@ void noteUnusualSituations()
   if(cwt.at->monst && !isMultitile(cwt.at->monst)) {
     // This is possible in multiple ways
     printf("on a non-multitile monster: %s\n", minf[cwt.at->monst].name);
+    farm_report(string("unusual on a non-multitile monster: ") + minf[cwt.at->monst].name);
     }
   else if(isDie(cwt.at->wall)) {
     // This is possible with aether + teleport
     printf("on a wall-type die: %s\n", winf[cwt.at->wall].name);
+    farm_report(string("unusual on a wall-type die: ") + winf[cwt.at->wall].name);
     }
   }
 
@@ -278,6 +295,7 @@ void stopIfBug()
 {
   if(isAnythingWrong()) {
     if(noGUI) {
+      farm_report("bug " + its(turncount));
       exit(1);
       }
     else {
@@ -393,6 +411,161 @@ void autoplay(int num_moves = 1000000000) {
     }
   }
 
+/* The autoplay farm: plays many games in parallel worker processes, with different seeds and geometries.
+ * The workers report their results over pipes, and the collector writes a summary to the report file.
+ * The full output of each game is in a separate log file. */
+
+namespace farm {
+
+/** the games are played in these geometries in turn */
+vector<pair<eGeometry, eVariation>> geometries = {
+  {gNormal, eVariation::bitruncated},
+  {gNormal, eVariation::pure},
+  {gEuclid, eVariation::bitruncated},
+  {gEuclidSquare, eVariation::pure},
+  {gOctagon, eVariation::pure},
+  {g45, eVariation::pure},
+  {g46, eVariation::pure},
+  {g47, eVariation::bitruncated}
+  };
+
+int first_seed = 1;
+
+/** a worker is killed if its game takes longer than this (in seconds) */
+int timeout = 3600;
+
+struct game {
+  int id, seed;
+  int pid, fd;
+  string buffer;
+  string geometry, status;
+  int turns;
+  double seconds;
+  vector<string> unusual;
+  };
+
+string logname(const string& report, int id) { return report + "-" + its(id) + ".log"; }
+
+void play(const game& g, int turns, const string& log, int fd) {
+  farm_fd = fd;
+  alarm(timeout);
+  if(!freopen(log.c_str(), "wt", stdout)) exit(1);
+  auto& geo = geometries[g.id % isize(geometries)];
+  stop_game();
+  set_geometry(geo.first);
+  set_variation(geo.second);
+  shrand(g.seed);
+  start_game();
+  farm_report("geometry " + full_geometry_name());
+  auto start = std::chrono::steady_clock::now();
+  autoplay(turns);
+  double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  farm_report("done " + its(turncount) + " " + fts(t));
+  fflush(stdout);
+  exit(0);
+  }
+
+void handle_line(game& g, const string& s) {
+  if(s.substr(0, 9) == "geometry ") g.geometry = s.substr(9);
+  else if(s.substr(0, 8) == "unusual ") g.unusual.push_back(s.substr(8));
+  else if(s.substr(0, 4) == "bug ") g.status = "bug", g.turns = atoi(s.c_str() + 4);
+  else if(s.substr(0, 5) == "done ") g.status = "ok", sscanf(s.c_str() + 5, "%d%lf", &g.turns, &g.seconds);
+  }
+
+/** read from the pipe of g; returns false when the worker has finished */
+bool collect(game& g) {
+  char buf[4096];
+  int n = read(g.fd, buf, sizeof(buf));
+  if(n > 0) {
+    g.buffer.append(buf, n);
+    size_t pos;
+    while((pos = g.buffer.find('\n')) != string::npos) {
+      handle_line(g, g.buffer.substr(0, pos));
+      g.buffer.erase(0, pos+1);
+      }
+    return true;
+    }
+  close(g.fd);
+  g.fd = -1;
+  int status;
+  waitpid(g.pid, &status, 0);
+  if(WIFSIGNALED(status))
+    g.status = WTERMSIG(status) == SIGALRM ? "timeout" : "crash (signal " + its(WTERMSIG(status)) + ")";
+  else if(g.status == "running")
+    g.status = "exit " + its(WEXITSTATUS(status));
+  return false;
+  }
+
+void write_report(vector<game>& games, int workers, double t, const string& report) {
+  int total = 0;
+  double worker_time = 0;
+  map<string, int> statuses, unusual;
+  for(auto& g: games) {
+    total += g.turns;
+    worker_time += g.seconds;
+    statuses[g.status]++;
+    for(auto& u: g.unusual) unusual[u]++;
+    }
+
+  fhstream f(report, "wt");
+  println(f, "autoplay farm: ", isize(games), " games, ", workers, " workers, ", fts(t), " s");
+  println(f, "turns: ", total, ", ", fts(total / t), " turns/s");
+  if(worker_time) println(f, "finished games: ", fts(total / worker_time), " turns/s per worker");
+  for(auto& p: statuses) println(f, p.first, ": ", p.second);
+  for(auto& p: unusual) println(f, "unusual (", p.second, "x): ", p.first);
+  println(f);
+  for(auto& g: games)
+    println(f, "game ", g.id, " seed ", g.seed, " ", g.geometry, ": ", g.status, ", ", g.turns, " turns",
+      g.seconds ? ", " + fts(g.turns / g.seconds) + " turns/s" : "",
+      g.unusual.empty() ? "" : ", " + its(isize(g.unusual)) + " unusual",
+      ", log: ", logname(report, g.id));
+  }
+
+void run(int workers, int qty, int turns, const string& report) {
+  vector<game> games(qty);
+  vector<int> running;
+  int next = 0;
+  auto start = std::chrono::steady_clock::now();
+
+  while(next < qty || !running.empty()) {
+    while(next < qty && isize(running) < workers) {
+      game& g = games[next];
+      g.id = next; g.seed = first_seed + next;
+      g.turns = 0; g.seconds = 0; g.status = "running";
+      int p[2];
+      if(pipe(p) < 0) { println(hlog, "autoplay farm: could not create a pipe"); exit(1); }
+      fflush(stdout);
+      int pid = fork();
+      if(pid == 0) {
+        close(p[0]);
+        play(g, turns, logname(report, g.id), p[1]);
+        }
+      close(p[1]);
+      if(pid < 0) { println(hlog, "autoplay farm: could not fork"); exit(1); }
+      g.pid = pid; g.fd = p[0];
+      running.push_back(next++);
+      }
+
+    vector<pollfd> fds;
+    for(int i: running) fds.push_back(pollfd{games[i].fd, POLLIN, 0});
+    if(poll(&fds[0], fds.size(), -1) < 0) continue;
+
+    vector<int> still_running;
+    for(int k=0; k<isize(fds); k++) {
+      game& g = games[running[k]];
+      if(!fds[k].revents || collect(g)) { still_running.push_back(running[k]); continue; }
+      println(hlog, "game ", g.id, " seed ", g.seed, " ", g.geometry, ": ", g.status, ", ", g.turns, " turns");
+      }
+    running = still_running;
+    }
+
+  double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  write_report(games, workers, t, report);
+  println(hlog, "autoplay farm: report written to ", report);
+  }
+
+}
+
 int readArgs() {
   using namespace arg;
            
@@ -413,6 +586,20 @@ int readArgs() {
     shift();
     autoplay(argi());
     }
+  else if(argis("-autoplay-farm-seed")) {
+    shift(); farm::first_seed = argi();
+    }
+  else if(argis("-autoplay-farm-timeout")) {
+    shift(); farm::timeout = argi();
+    }
+  else if(argis("-autoplay-farm")) {
+    // -autoplay-farm <workers> <games> <turns per game> <report file>
+    PHASE(3);
+    shift(); int workers = argi();
+    shift(); int qty = argi();
+    shift(); int turns = argi();
+    shift(); farm::run(workers, qty, turns, args());
+    }
 
   else return 1;
   return 0;
@@ -0,0 +1,251 @@
+// Microbenchmark for the basic matrix routines.
+// Compares the current implementation (SIMD kernels when CAP_SIMD) with the plain loops,
+// and in 2D hyperbolic geometry, with the fixdim:: specializations.
+// Usage: hyperrogue -geo 534 -bench-matrix 1000000
+
+#include "../hyper.h"
+#include <chrono>
+
+namespace hr {
+
+namespace matrix_bench {
+
+/* the plain loops, as used when CAP_SIMD is off */
+
+hyperpoint loop_mul(const transmatrix& T, const hyperpoint& H) {
+  hyperpoint z;
+  for(int i=0; i<MXDIM; i++) {
+    z[i] = 0;
+    for(int j=0; j<MXDIM; j++) z[i] += T[i][j] * H[j];
+    }
+  return z;
+  }
+
+transmatrix loop_mul(const transmatrix& T, const transmatrix& U) {
+  transmatrix R;
+  for(int i=0; i<MXDIM; i++) for(int j=0; j<MXDIM; j++) {
+    R[i][j] = 0;
+    for(int k=0; k<MXDIM; k++)
+      R[i][j] += T[i][k] * U[k][j];
+    }
+  return R;
+  }
+
+transmatrix loop_inverse(const transmatrix& T) {
+  if(MDIM == 3) return inverse3(T);
+  transmatrix T1 = T;
+  transmatrix T2 = Id;
+  for(int a=0; a<MDIM; a++) {
+    int best = a;
+    for(int b=a+1; b<MDIM; b++)
+      if(abs(T1[b][a]) > abs(T1[best][a]))
+        best = b;
+    int b = best;
+    if(b != a)
+      for(int c=0; c<MDIM; c++)
+        swap(T1[b][c], T1[a][c]), swap(T2[b][c], T2[a][c]);
+    if(!T1[a][a]) return Id;
+    for(int b=a+1; b<=GDIM; b++) {
+      ld co = -T1[b][a] / T1[a][a];
+      for(int c=0; c<MDIM; c++) T1[b][c] += T1[a][c] * co, T2[b][c] += T2[a][c] * co;
+      }
+    }
+  for(int a=MDIM-1; a>=0; a--) {
+    for(int b=0; b<a; b++) {
+      ld co = -T1[b][a] / T1[a][a];
+      for(int c=0; c<MDIM; c++) T1[b][c] += T1[a][c] * co, T2[b][c] += T2[a][c] * co;
+      }
+    ld co = 1 / T1[a][a];
+    for(int c=0; c<MDIM; c++) T1[a][c] *= co, T2[a][c] *= co;
+    }
+  return T2;
+  }
+
+transmatrix loop_iso_inverse(transmatrix T) {
+  if(!hyperbolic && !sphere) return loop_inverse(T);
+  for(int i=1; i<MXDIM; i++)
+    for(int j=0; j<i; j++)
+      swap(T[i][j], T[j][i]);
+  if(hyperbolic)
+    for(int i=0; i<MDIM-1; i++)
+      T[i][MDIM-1] = -T[i][MDIM-1],
+      T[MDIM-1][i] = -T[MDIM-1][i];
+  return T;
+  }
+
+transmatrix loop_gpushxto0(const hyperpoint& H) {
+  transmatrix res = Id;
+  if(sqhypot_d(GDIM, H) < 1e-16) return res;
+  ld fac = -curvature()/(H[LDIM]+1);
+  for(int i=0; i<GDIM; i++)
+  for(int j=0; j<GDIM; j++)
+    res[i][j] += H[i] * H[j] * fac;
+  for(int d=0; d<GDIM; d++)
+    res[d][LDIM] = -H[d],
+    res[LDIM][d] = curvature() * H[d];
+  res[LDIM][LDIM] = H[LDIM];
+  return res;
+  }
+
+ld loop_intval(const hyperpoint &h1, const hyperpoint &h2) {
+  ld res = 0;
+  for(int i=0; i<MDIM; i++) res += squar(h1[i] - h2[i]) * sig(i);
+  return res;
+  }
+
+ld loop_hdist(const hyperpoint& h1, const hyperpoint& h2) {
+  ld iv = loop_intval(h1, h2);
+  if(iv < 0) return 0;
+  return 2 * asinh(sqrt(iv) / 2);
+  }
+
+hyperpoint loop_normalize(hyperpoint H) {
+  ld Z = (H[LDIM] < 0 ? -1 : 1) * sqrt(-loop_intval(H, Hypc));
+  for(int c=0; c<MXDIM; c++) H[c] /= Z;
+  return H;
+  }
+
+ld sink;
+
+void consume(const transmatrix& T) { sink += T[0][0]; }
+void consume(const hyperpoint& h) { sink += h[0]; }
+void consume(ld x) { sink += x; }
+
+/** the best of five runs, in nanoseconds per call */
+template<class F> ld timeit(int n, const F& f) {
+  ld best = HUGE_VAL;
+  for(int r=0; r<5; r++) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for(int i=0; i<n; i++) f(i);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    best = min<ld>(best, std::chrono::duration<double, std::nano>(t1 - t0).count() / n);
+    }
+  return best;
+  }
+
+ld maxerr(const transmatrix& A, const transmatrix& B) {
+  ld e = 0;
+  for(int i=0; i<MXDIM; i++) for(int j=0; j<MXDIM; j++) e = max(e, abs(A[i][j] - B[i][j]));
+  return e;
+  }
+
+void bench(int n) {
+  start_game();
+  println(hlog, "geometry: ", full_geometry_name(), " MDIM = ", MDIM, " CAP_SIMD = ", CAP_SIMD);
+
+  const int q = 256;
+  vector<transmatrix> Ms(q);
+  vector<hyperpoint> hs(q);
+  for(int i=0; i<q; i++) {
+    hyperpoint h = GDIM == 3 ? point31(randd()-.5, randd()-.5, randd()-.5) : hpxyz(randd()-.5, randd()-.5, 1);
+    hs[i] = normalize(h);
+    Ms[i] = rgpushxto0(hs[i]) * cspin(0, 1, randd() * 7);
+    }
+
+  ld err = 0;
+  for(int i=0; i<q; i++) {
+    auto& A = Ms[i]; auto& B = Ms[(i+1) % q];
+    err = max(err, maxerr(A * B, loop_mul(A, B)));
+    err = max(err, sqhypot_d(MXDIM, A * hs[i] - loop_mul(A, hs[i])));
+    err = max(err, maxerr(inverse(A), loop_inverse(A)));
+    err = max(err, maxerr(iso_inverse(A), loop_iso_inverse(A)));
+    err = max(err, maxerr(gpushxto0(hs[i]), loop_gpushxto0(hs[i])));
+    }
+  println(hlog, "max error: ", err);
+
+  auto report = [&] (string name, ld loop, ld cur, ld kernel) {
+    print(hlog, lalign(16, name), " loops: ", lalign(10, fts(loop)), " ns   current: ", lalign(10, fts(cur)), " ns");
+    if(kernel) print(hlog, "   kernel: ", lalign(10, fts(kernel)), " ns   speedup: ", fts(loop / kernel));
+    println(hlog);
+    };
+
+  auto& M = Ms;
+  auto& H = hs;
+
+  /* the SIMD kernels work on full 4x4 matrices */
+  #if CAP_SIMD
+  #define KERNEL(x) (MXDIM == 4 ? timeit(n, [&] (int i) { x; }) : 0)
+  #else
+  #define KERNEL(x) 0
+  #endif
+
+  report("matrix*matrix",
+    timeit(n, [&] (int i) { consume(loop_mul(M[i & 255], M[(i+1) & 255])); }),
+    timeit(n, [&] (int i) { consume(M[i & 255] * M[(i+1) & 255]); }),
+    KERNEL(transmatrix R; simd::mul_mm(M[i & 255].tab[0], M[(i+1) & 255].tab[0], R.tab[0]); consume(R)));
+  report("matrix*point",
+    timeit(n, [&] (int i) { consume(loop_mul(M[i & 255], H[(i+1) & 255])); }),
+    timeit(n, [&] (int i) { consume(M[i & 255] * H[(i+1) & 255]); }),
+    KERNEL(hyperpoint h; simd::mul_mv(M[i & 255].tab[0], &H[(i+1) & 255][0], &h[0]); consume(h)));
+  report("inverse",
+    timeit(n, [&] (int i) { consume(loop_inverse(M[i & 255])); }),
+    timeit(n, [&] (int i) { consume(inverse(M[i & 255])); }),
+    KERNEL(transmatrix R; simd::inverse(M[i & 255].tab[0], R.tab[0]); consume(R)));
+  report("iso_inverse",
+    timeit(n, [&] (int i) { consume(loop_iso_inverse(M[i & 255])); }),
+    timeit(n, [&] (int i) { consume(iso_inverse(M[i & 255])); }),
+    KERNEL(transmatrix R; simd::transpose_signed(M[i & 255].tab[0], R.tab[0], simd::make_row(1, 1, 1, -1), simd::make_row(-1, -1, -1, 1)); consume(R)));
+  report("gpushxto0",
+    timeit(n, [&] (int i) { consume(loop_gpushxto0(H[i & 255])); }),
+    timeit(n, [&] (int i) { consume(gpushxto0(H[i & 255])); }),
+    KERNEL(auto& h = H[i & 255]; transmatrix R; simd::gpush(&h[0], -curvature()/(h[3]+1), -1, curvature(), R.tab[0]); consume(R)));
+
+  #undef KERNEL
+
+  if(!hyperbolic || MDIM != 3) return;
+
+  println(hlog, "2D hyperbolic: runtime API vs fixdim<gcHyperbolic, 3>");
+  using namespace fixdim;
+  auto report3 = [&] (string name, ld loop, ld cur, ld fixed) {
+    println(hlog, lalign(16, name), " loops: ", lalign(10, fts(loop)), " ns   current: ", lalign(10, fts(cur)), " ns   fixdim: ", lalign(10, fts(fixed)), " ns   speedup: ", fts(loop / fixed));
+    };
+
+  report3("matrix*matrix",
+    timeit(n, [&] (int i) { consume(loop_mul(M[i & 255], M[(i+1) & 255])); }),
+    timeit(n, [&] (int i) { consume(M[i & 255] * M[(i+1) & 255]); }),
+    timeit(n, [&] (int i) { transmatrix R; mul<3>(M[i & 255], M[(i+1) & 255], R); consume(R); }));
+  report3("inverse",
+    timeit(n, [&] (int i) { consume(loop_inverse(M[i & 255])); }),
+    timeit(n, [&] (int i) { consume(inverse(M[i & 255])); }),
+    timeit(n, [&] (int i) { transmatrix R; inverse3(M[i & 255], R); consume(R); }));
+  report3("iso_inverse",
+    timeit(n, [&] (int i) { consume(loop_iso_inverse(M[i & 255])); }),
+    timeit(n, [&] (int i) { consume(iso_inverse(M[i & 255])); }),
+    timeit(n, [&] (int i) { consume(fixdim::iso_inverse<gcHyperbolic, 3>(M[i & 255])); }));
+  report3("hdist0",
+    timeit(n, [&] (int i) { consume(acosh(tC0(M[i & 255])[LDIM])); }),
+    timeit(n, [&] (int i) { consume(hdist0(tC0(M[i & 255]))); }),
+    timeit(n, [&] (int i) { consume(fixdim::hdist0<gcHyperbolic, 3>(fixdim::tC0<3>(M[i & 255]))); }));
+  report3("hdist",
+    timeit(n, [&] (int i) { consume(loop_hdist(H[i & 255], H[(i+1) & 255])); }),
+    timeit(n, [&] (int i) { consume(hdist(H[i & 255], H[(i+1) & 255])); }),
+    timeit(n, [&] (int i) { consume(fixdim::hdist<gcHyperbolic, 3>(H[i & 255], H[(i+1) & 255])); }));
+  report3("normalize",
+    timeit(n, [&] (int i) { consume(loop_normalize(H[i & 255] * 2)); }),
+    timeit(n, [&] (int i) { consume(normalize(H[i & 255] * 2)); }),
+    timeit(n, [&] (int i) { consume(fixdim::normalize<gcHyperbolic, 3>(H[i & 255] * 2)); }));
+
+  ld err3 = 0;
+  for(int i=0; i<q; i++) {
+    err3 = max(err3, abs(hdist(H[i], H[(i+1) % q]) - loop_hdist(H[i], H[(i+1) % q])));
+    err3 = max(err3, sqhypot_d(3, normalize(H[i] * 2) - loop_normalize(H[i] * 2)));
+    }
+  println(hlog, "max error: ", err3);
+  }
+
+int readArgs() {
+  using namespace arg;
+
+  if(0) ;
+  else if(argis("-bench-matrix")) {
+    PHASEFROM(3);
+    shift(); bench(argi());
+    }
+  else return 1;
+  return 0;
+  }
+
+auto hook = addHook(hooks_args, 100, readArgs);
+
+}
+}
@@ -17,6 +17,11 @@
 // Add e.g. '-dim 128 128 128' before -write to generate
 // a more/less precise table.
 
+// The higher-resolution tables are used by HyperRogue instead of the
+// standard ones when it is run with '-sol-hires 1'; they are memory-mapped
+// too, so only the parts actually used are read:
+// [executable] -dim 128 128 128 -geo sol -build -write solv-geodesics-hires.dat
+
 // # ./hyper -geo Sol -iz-list -sn-unittest -build -write solv-geodesics-a.dat -visualize devmods/san1/solva-%04d.png -improve -write solv-geodesics.dat -visualize devmods/san1/solvb-%04d.png
 // # ./hyper -dim 32 32 32 -geo 3:1/2 -iz-list -sn-unittest -build -write ssol-geodesics-a.dat -visualize devmods/san1/ssola-%04d.png -improve -write ssol-geodesics.dat -visualize devmods/san1/ssolb-%04d.png
 // # ./hyper -dim 32 32 32 -geo 3:2 -iz-list -sn-unittest -build -write shyp-geodesics.dat -visualize devmods/san1/shypa-%04d.png
@@ -150,18 +155,20 @@ void ffloat(FILE *f, float x) { fwrite(&x, sizeof(x), 1, f); }
 
 void write_table(sn::tabled_inverses& tab, const char *fname) {
   FILE *f = fopen(fname, "wb");
-  fint(f, tab.PRECX);
-  fint(f, tab.PRECY);
-  fint(f, tab.PRECZ);
+  sn::table_header h;
+  memcpy(h.magic, sn::table_magic, 4);
+  h.version = sn::table_version;
+  h.PRECX = tab.PRECX;
+  h.PRECY = tab.PRECY;
+  h.PRECZ = tab.PRECZ;
+  h.offset = sizeof(h);
+  fwrite(&h, sizeof(h), 1, f);
   fwrite(&tab.tab[0], sizeof(ptlow) * tab.PRECX * tab.PRECY * tab.PRECZ, 1, f);
   fclose(f);
   }
 
 void alloc_table(sn::tabled_inverses& tab, int X, int Y, int Z) {
-  tab.PRECX = X;
-  tab.PRECY = Y;
-  tab.PRECZ = Z;
-  tab.tab.resize(X*Y*Z);
+  tab.allocate(X, Y, Z);
   }
 
 ld ptd(ptlow p) {
@@ -0,0 +1,88 @@
+// Headless benchmark of the game turns: plays random moves from a fixed seed, without drawing anything,
+// and reports the turns per second, the time spent in the main phases of the turn, and a hash of the final state.
+// The hash is the same for every run with the same parameters, so it also detects changes in the game behavior.
+//
+// Build without graphics: mymake -sdl0 devmods/turn-bench
+// Usage: hyperrogue -nogui [-W Icy] [-turn-bench-seed 1] -turn-bench 10000
+
+#include "../hyper.h"
+
+namespace hr {
+
+namespace turn_bench {
+
+int seed = 1;
+
+/** hash of the things which the turns could change */
+unsigned state_hash() {
+  unsigned h = 0;
+  auto mix = [&] (unsigned x) { h = (h ^ x) * 16777619u; };
+  mix(turncount); mix(gold()); mix(tkills()); mix(celldist(cwt.at));
+  for(int i=0; i<ittypes; i++) mix(items[i]);
+  for(cell *c: dcal) {
+    mix(c->land); mix(c->wall); mix(c->monst); mix(c->item);
+    mix(c->wparam);
+    /* stuntime is not cleared when the monster leaves, and hitpoints are not initialized for most monsters */
+    if(c->monst) mix(c->stuntime);
+    }
+  /* also detect changes in the use of the random number generator */
+  std::mt19937 r = hrngen;
+  mix(r());
+  return h;
+  }
+
+void run(int turns) {
+  stop_game();
+  shrand(seed);
+  start_game();
+  items[itWarning] = 1;
+
+  turn_timing::reset();
+  turn_timing::on = true;
+
+  int deaths = 0, failed = 0;
+  auto start = std::chrono::steady_clock::now();
+  int done = 0;
+  while(done < turns && failed < 10 * turns) {
+    if(!canmove) {
+      deaths++;
+      restart_game();
+      items[itWarning] = 1;
+      }
+    cwt.spin = 0;
+    int d = hrand(cwt.at->type);
+    if(movepcto(d, 1, false) || movepcto(MD_WAIT, 1, false)) done++;
+    else failed++;
+    }
+  double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  turn_timing::on = false;
+
+  println(hlog, "turns: ", done, " deaths: ", deaths, " failed moves: ", failed);
+  println(hlog, "time: ", fts(t), " s, ", fts(done / t), " turns/s");
+  for(auto p: turn_timing::phases())
+    println(hlog, lalign(14, p->name), lalign(10, fts(p->seconds * 1e3)), " ms ", lalign(8, fts(100 * p->seconds / t)), " % calls: ", p->calls);
+  println(hlog, "(the phases overlap: monstersTurn includes bfs and heat, and some of the setdist calls are made from bfs)");
+  println(hlog, "state hash: ", format("%08x", state_hash()));
+  }
+
+int readArgs() {
+  using namespace arg;
+
+  if(0) ;
+  else if(argis("-turn-bench-seed")) {
+    shift(); seed = argi();
+    }
+  else if(argis("-turn-bench")) {
+    PHASE(3);
+    shift(); run(argi());
+    }
+
+  else return 1;
+  return 0;
+  }
+
+auto hook = addHook(hooks_args, 100, readArgs);
+
+}
+}
@@ -45,6 +45,32 @@ static const int POLY_ONE_LEVEL = (1<<28);      // only one level of the univers
  *  which store the data to draw in hr::ptds. This approach lets us draw the elements in the correct order. 
  */
 
+/** \brief Bump allocator for drawqueueitems of one size.
+ *
+ *  Items are destroyed in bulk at the end of each frame; once no item allocated from
+ *  the pool is alive, the pool rewinds to its first chunk, so the memory is reused
+ *  from frame to frame without calls to the general allocator.
+ */
+struct dqi_pool {
+  static const int chunk_objects = 256;
+  int objsize;
+  vector<char*> chunks;
+  int chunk_id;
+  char *next, *end;
+  int live;
+  dqi_pool(int s) { objsize = s; chunk_id = -1; next = end = nullptr; live = 0; }
+  void *alloc();
+  void free(void *p);
+  };
+
+/** \brief A graphical element that can be drawn. Objects are not drawn immediately but rather queued.
+ *
+ *  HyperRogue map rendering functions do not draw its data immediately; instead, they call the 'queue' functions
+ *  which store the data to draw in hr::ptds. This approach lets us draw the elements in the correct order. 
+ *
+ *  The items are allocated from the dqi_pool for their size, i.e., there is one pool for each of dqi_poly, dqi_line, etc.
+ */
+
 struct drawqueueitem {
   /** \brief The higher the priority, the earlier we should draw this object. */
   PPR prio;
@@ -59,6 +85,8 @@ struct drawqueueitem {
   virtual ~drawqueueitem() = default;
   /** \brief When minimizing OpenGL calls, we need to group items of the same color, etc. together. This value is used as an extra sorting key. */
   virtual color_t outline_group() = 0;
+  static void *operator new(size_t s);
+  static void operator delete(void *p, size_t s);
   };
 
 /** \brief Drawqueueitem used to draw polygons. The majority of drawqueueitems fall here. */
@@ -156,6 +184,44 @@ EX color_t poly_outline;
 
 EX vector<unique_ptr<drawqueueitem>> ptds;
 
+void *dqi_pool::alloc() {
+  live++;
+  if(next == end) {
+    chunk_id++;
+    if(chunk_id == isize(chunks)) chunks.push_back(new char[objsize * chunk_objects]);
+    next = chunks[chunk_id];
+    end = next + objsize * chunk_objects;
+    }
+  void *res = next;
+  next += objsize;
+  return res;
+  }
+
+void dqi_pool::free(void *p) {
+  live--;
+  if(!live) {
+    chunk_id = -1;
+    next = end = nullptr;
+    }
+  }
+
+/** \brief the pools, indexed by size/8 */
+vector<dqi_pool*>& dqi_pools() {
+  static vector<dqi_pool*> pools;
+  return pools;
+  }
+
+dqi_pool& dqi_pool_for(size_t s) {
+  auto& pools = dqi_pools();
+  int id = int((s + 7) >> 3);
+  if(id >= isize(pools)) pools.resize(id+1, nullptr);
+  if(!pools[id]) pools[id] = new dqi_pool(id << 3);
+  return *pools[id];
+  }
+
+void *drawqueueitem::operator new(size_t s) { return dqi_pool_for(s).alloc(); }
+void drawqueueitem::operator delete(void *p, size_t s) { dqi_pool_for(s).free(p); }
+
 #if CAP_GL
 EX color_t text_color;
 EX int text_shift;
@@ -385,6 +451,8 @@ void fixpoint(glvertex& hscr, hyperpoint H) {
     hscr = glhr::makevertex(Hscr[0]*current_display->radius, Hscr[1]*current_display->radius*pconf.stretch, Hscr[2]*current_display->radius); 
   }
 
+void add_screen_point(hyperpoint Hscr, ld z);
+
 void addpoint(const shiftpoint& H) {
   if(true) {
     ld z = current_display->radius;
@@ -434,25 +502,30 @@ void addpoint(const shiftpoint& H) {
         }
       Hlast = Hscr;
       }
-    #if CAP_VR
-    if(vrhr::rendering()) {
-      for(int i=0; i<3; i++) Hscr[i] *= z;
-      }
-    else
-    #endif
-    if(GDIM == 2) {
-      for(int i=0; i<3; i++) Hscr[i] *= z;
-      Hscr[1] *= pconf.stretch;
-      }
-    else {
-      Hscr[0] *= z;
-      Hscr[1] *= z * pconf.stretch;
-      Hscr[2] = 1 - 2 * (-Hscr[2] - pconf.clip_min) / (pconf.clip_max - pconf.clip_min);
-      }
-    add1(Hscr);
+    add_screen_point(Hscr, z);
     }
   }
 
+/** Hscr is the result of applymodel, z is the scale */
+void add_screen_point(hyperpoint Hscr, ld z) {
+  #if CAP_VR
+  if(vrhr::rendering()) {
+    for(int i=0; i<3; i++) Hscr[i] *= z;
+    }
+  else
+  #endif
+  if(GDIM == 2) {
+    for(int i=0; i<3; i++) Hscr[i] *= z;
+    Hscr[1] *= pconf.stretch;
+    }
+  else {
+    Hscr[0] *= z;
+    Hscr[1] *= z * pconf.stretch;
+    Hscr[2] = 1 - 2 * (-Hscr[2] - pconf.clip_min) / (pconf.clip_max - pconf.clip_min);
+    }
+  add1(Hscr);
+  }
+
 void coords_to_poly() {
   polyi = isize(glcoords);
   for(int i=0; i<polyi; i++) {
@@ -470,6 +543,42 @@ bool behind3(shiftpoint h) {
   return h[2] < 0;
   }
 
+vector<shiftpoint> geodesic_points;
+vector<hyperpoint> geodesic_dirs;
+
+/** addpoly in the geodesic model: inverse_exp is computed once per vertex, for all the vertices at once,
+ *  and the result is used both for the behind test and for the projection
+ */
+void addpoly_geodesic(const shiftmatrix& V, const vector<glvertex> &tab, int ofs, int cnt) {
+  geodesic_points.resize(cnt);
+  geodesic_dirs.resize(cnt);
+  for(int i=0; i<cnt; i++) geodesic_points[i] = V * glhr::gltopoint(tab[ofs+i]);
+  /* pfNO_DISTANCE only rescales the result, so it does not change the behind test */
+  inverse_exp_array(&geodesic_points[0], &geodesic_dirs[0], cnt, pNORMAL | pfNO_DISTANCE);
+  for(auto& h: geodesic_dirs) h = lp_apply(h);
+
+  ld z = current_display->radius;
+  #if CAP_VR
+  if(vrhr::rendering()) z = 1;
+  #endif
+  
+  auto add = [&] (int i) {
+    hyperpoint Hscr;
+    apply_perspective(geodesic_dirs[i], Hscr);
+    add_screen_point(Hscr, z);
+    };
+  auto behind = [&] (int i) { return geodesic_dirs[i][2] < 0; };
+
+  if(poly_flags & POLY_TRIANGLES) {
+    for(int i=0; i+2<cnt; i+=3)
+      if(!behind(i) && !behind(i+1) && !behind(i+2))
+        add(i), add(i+1), add(i+2);
+    }
+  else {
+    for(int i=0; i<cnt; i++) if(!behind(i)) add(i);
+    }
+  }
+
 void addpoly(const shiftmatrix& V, const vector<glvertex> &tab, int ofs, int cnt) {
   if(pmodel == mdPixel) {
     for(int i=ofs; i<ofs+cnt; i++) {
@@ -483,6 +592,10 @@ void addpoly(const shiftmatrix& V, const vector<glvertex> &tab, int ofs, int cnt
     return;
     }
   tofix.clear(); knowgood = false;
+  if(pmodel == mdGeodesic && !spherespecial && !models::product_model(pmodel) && cnt) {
+    addpoly_geodesic(V, tab, ofs, cnt);
+    return;
+    }
   if(among(pmodel, mdPerspective, mdGeodesic)) {
     if(poly_flags & POLY_TRIANGLES) {
       for(int i=ofs; i<ofs+cnt; i+=3) {
@@ -2167,6 +2280,13 @@ void dqi_line::draw_back() {
   draw();
   }
 
+/** \brief time taken by sorting the drawing queue in the last frame, in microseconds; shown next to fps with DF_GRAPH */
+EX int sort_drawqueue_time;
+
+/** \brief temporary buffer for sort_drawqueue, kept between frames to avoid reallocation */
+vector<unique_ptr<drawqueueitem>> ptds_sorted;
+
+/** \brief stable counting sort of ptds by PPR; qp0[p] and qp[p] are the bounds of PPR p afterwards */
 EX void sort_drawqueue() {
   DEBBI(DF_GRAPH, ("sort_drawqueue"));
   
@@ -2175,14 +2295,20 @@ EX void sort_drawqueue() {
   int siz = isize(ptds);
 
   #if MINIMIZE_GL_CALLS
-  map<color_t, vector<unique_ptr<drawqueueitem>>> subqueue;
-  for(auto& p: ptds) subqueue[(p->prio == PPR::CIRCLE || p->prio == PPR::OUTCIRCLE) ? 0 : p->outline_group()].push_back(move(p));
-  ptds.clear();
-  for(auto& p: subqueue) for(auto& r: p.second) ptds.push_back(move(r));
-  subqueue.clear();
-  for(auto& p: ptds) subqueue[(p->prio == PPR::CIRCLE || p->prio == PPR::OUTCIRCLE) ? 0 : p->color].push_back(move(p));
-  ptds.clear();
-  for(auto& p: subqueue) for(auto& r: p.second) ptds.push_back(move(r));
+  /* group by color, then by outline group, keeping the original order otherwise */
+  struct glkey { color_t color, group; int id; };
+  vector<glkey> keys(siz);
+  for(int i=0; i<siz; i++) {
+    auto& p = ptds[i];
+    bool circle = p->prio == PPR::CIRCLE || p->prio == PPR::OUTCIRCLE;
+    keys[i] = glkey{circle ? 0 : p->color, circle ? 0 : p->outline_group(), i};
+    }
+  sort(keys.begin(), keys.end(), [] (const glkey& a, const glkey& b) {
+    return tie(a.color, a.group, a.id) < tie(b.color, b.group, b.id);
+    });
+  ptds_sorted.resize(siz);
+  for(int i=0; i<siz; i++) ptds_sorted[i] = move(ptds[keys[i].id]);
+  swap(ptds, ptds_sorted);
   #endif
     
   for(auto& p: ptds) {
@@ -2200,11 +2326,40 @@ EX void sort_drawqueue() {
     qp0[a] = qp[a] = total; total += b;
     }
 
-  vector<unique_ptr<drawqueueitem>> ptds2;  
-  ptds2.resize(siz);
+  ptds_sorted.resize(siz);
   
-  for(int i = 0; i<siz; i++) ptds2[qp[int(ptds[i]->prio)]++] = move(ptds[i]);
-  swap(ptds, ptds2);
+  for(int i = 0; i<siz; i++) ptds_sorted[qp[int(ptds[i]->prio)]++] = move(ptds[i]);
+  swap(ptds, ptds_sorted);
+  ptds_sorted.clear();
+  }
+
+/** \brief the second pass of sorting: some priorities are ordered by depth inside */
+EX void sort_subpriorities() {
+  DEBBI(DF_GRAPH, ("sort walls"));
+
+  if(GDIM == 2) 
+  for(PPR p: {PPR::REDWALLs, PPR::REDWALLs2, PPR::REDWALLs3, PPR::WALL3s,
+    PPR::LAKEWALL, PPR::INLAKEWALL, PPR::BELOWBOTTOM, PPR::ASHALLOW, PPR::BSHALLOW}) {
+    int pp = int(p);
+    if(qp0[pp] == qp[pp]) continue;
+    for(int i=qp0[pp]; i<qp[pp]; i++) {
+      auto& ap = (dqi_poly&) *ptds[i];
+      ap.cache = xintval(ap.V * xpush0(.1));
+      }
+    stable_sort(&ptds[qp0[pp]], &ptds[qp[pp]], 
+      [] (const unique_ptr<drawqueueitem>& p1, const unique_ptr<drawqueueitem>& p2) {
+        return ((dqi_poly&) *p1).cache < ((dqi_poly&) *p2).cache;
+        });
+    }
+
+  for(PPR p: {PPR::TRANSPARENT_WALL}) {
+    int pp = int(p);
+    if(qp0[pp] == qp[pp]) continue;
+    stable_sort(&ptds[qp0[int(p)]], &ptds[qp[int(p)]], 
+      [] (const unique_ptr<drawqueueitem>& p1, const unique_ptr<drawqueueitem>& p2) {
+        return p1->subprio > p2->subprio;
+        });
+    }
   }
 
 EX void reverse_priority(PPR p) {
@@ -2274,6 +2429,89 @@ EX void set_vr_sphere() {
   #endif
   }
 
+#if CAP_INSTANCING
+/** can runs of the same static shape be drawn with a single instanced call in this frame */
+bool instancing_possible() {
+  return glhr::instancing && glhr::instancing_supported && vid.usingGL && !glhr::noshaders &&
+    !current_display->stereo_active() && !vrhr::rendering() && !sphere && !sl2 && !in_s2xe() &&
+    !models::get_broken_coord(pmodel) && !(among(pmodel, mdPolygonal, mdPolynomial) && !hyperbolic) &&
+    !(debugflags & DF_VERTEX);
+  }
+
+/** a polygon which can be drawn from the persistent shape buffer with only its matrix given per instance */
+dqi_poly *instanceable(drawqueueitem *ptd) {
+  auto p = dynamic_cast<dqi_poly*> (ptd);
+  if(!p || p->tab != &cgi.ourshape || p->tinf) return nullptr;
+  if(p->flags & (POLY_INVERSE | POLY_FORCE_INVERTED | POLY_DEBUG)) return nullptr;
+  if(p->flags & POLY_TRIANGLES) return p->outline ? nullptr : p;
+  /* convex fans can be drawn directly, without the stencil trick */
+  if((p->flags & POLY_VCONVEX) && !(p->flags & POLY_CCONVEX)) return p;
+  return nullptr;
+  }
+
+/** find the end of the run of items starting at ptds[i] which differ only in their matrices */
+int instanced_run(int i) {
+  auto p = instanceable(&*ptds[i]);
+  if(!p) return i+1;
+  int j = i+1;
+  ld width = p->outline ? get_width(p) : 0;
+  while(j < isize(ptds)) {
+    auto q = instanceable(&*ptds[j]);
+    if(!q || q->offset != p->offset || q->cnt != p->cnt || q->color != p->color || q->outline != p->outline) break;
+    if(q->prio != p->prio || q->flags != p->flags || q->V.shift != p->V.shift || q->linewidth != p->linewidth) break;
+    if(p->outline && get_width(q) != width) break;
+    j++;
+    }
+  return j;
+  }
+
+vector<GLfloat> instance_data;
+
+/** draw ptds[i..j), found by instanced_run, with one instanced call per pass */
+void draw_instanced(int i, int j) {
+  auto& p = (dqi_poly&) *ptds[i];
+  glflush();
+  current_display->next_shader_flags = GF_INSTANCED;
+  current_display->set_all(0, p.V.shift);
+  flagtype sp = get_shader_flags();
+  if(!(sp & SF_DIRECT) || (sp & SF_BAND)) {
+    glhr::be_nontextured();
+    for(int k=i; k<j; k++) ptds[k]->draw();
+    return;
+    }
+  if(p.outline) set_width(get_width(&p));
+
+  int n = j - i;
+  instance_data.resize(16 * n);
+  for(int k=0; k<n; k++)
+    matrix_to_gl(((dqi_poly&) *ptds[i+k]).V.T, &instance_data[16*k]);
+
+  glapplymatrix(Id);
+  glhr::shape_vertices(*p.tab);
+  glhr::instance_matrices(instance_data);
+
+  auto set_depth = [&] {
+    glhr::set_depthtest(model_needs_depth() && p.prio < PPR::SUPERLINE);
+    glhr::set_depthwrite(model_needs_depth() && p.prio != PPR::TRANSPARENT_SHADOW && p.prio != PPR::EUCLIDEAN_SKY);
+    glhr::set_fogbase(p.prio == PPR::SKY ? 1.0 + (euclid ? 20 : 5 / sightranges[geometry]) : 1.0);
+    };
+
+  if(p.color) {
+    bool tri = p.flags & POLY_TRIANGLES;
+    glhr::color2(p.color, (tri && (p.flags & POLY_INTENSE)) ? 2 : 1);
+    set_depth();
+    glDrawArraysInstanced(tri ? GL_TRIANGLES : GL_TRIANGLE_FAN, p.offset, p.cnt, n);
+    }
+  if(p.outline) {
+    glhr::color2(p.outline);
+    set_depth();
+    glDrawArraysInstanced(GL_LINE_STRIP, p.offset, p.cnt, n);
+    }
+  glhr::end_instances();
+  glhr::be_nontextured();
+  }
+#endif
+
 EX void draw_main() {
   DEBBI(DF_GRAPH, ("draw_main"));
   
@@ -2353,8 +2591,19 @@ EX void draw_main() {
     
     if(two_sided_model()) draw_backside();
   
-    for(auto& ptd: ptds) if(ptd->prio != PPR::OUTCIRCLE) {
+    #if CAP_INSTANCING
+    bool instancing = instancing_possible();
+    #endif
+    for(int i=0; i<isize(ptds); i++) {
+      auto& ptd = ptds[i];
+      if(ptd->prio == PPR::OUTCIRCLE) continue;
       DEBBI(DF_VERTEX, ("prio: ", int(ptd->prio), " color ", ptd->color));
+      #if CAP_INSTANCING
+      if(instancing) {
+        int j = instanced_run(i);
+        if(j > i+1) { draw_instanced(i, j); i = j-1; continue; }
+        }
+      #endif
       dynamicval<int> ss(spherespecial, among(ptd->prio, PPR::MOBILE_ARROW, PPR::OUTCIRCLE, PPR::CIRCLE) ? 0 : spherespecial);
       ptd->draw();
       }
@@ -2404,35 +2653,10 @@ EX void drawqueue() {
     glClear(GL_STENCIL_BUFFER_BIT);
 #endif
   
+  auto sort_start = std::chrono::steady_clock::now();
   sort_drawqueue();
-
-  DEBB(DF_GRAPH, ("sort walls"));
-  
-  if(GDIM == 2) 
-  for(PPR p: {PPR::REDWALLs, PPR::REDWALLs2, PPR::REDWALLs3, PPR::WALL3s,
-    PPR::LAKEWALL, PPR::INLAKEWALL, PPR::BELOWBOTTOM, PPR::ASHALLOW, PPR::BSHALLOW}) {
-    int pp = int(p);
-    if(qp0[pp] == qp[pp]) continue;
-    for(int i=qp0[pp]; i<qp[pp]; i++) {
-      auto ap = (dqi_poly&) *ptds[i];
-      ap.cache = xintval(ap.V * xpush0(.1));
-      }
-    sort(&ptds[qp0[pp]], &ptds[qp[pp]], 
-      [] (const unique_ptr<drawqueueitem>& p1, const unique_ptr<drawqueueitem>& p2) {
-        auto ap1 = (dqi_poly&) *p1;
-        auto ap2 = (dqi_poly&) *p2;
-        return ap1.cache < ap2.cache;
-        });
-    }
-
-  for(PPR p: {PPR::TRANSPARENT_WALL}) {
-    int pp = int(p);
-    if(qp0[pp] == qp[pp]) continue;
-    sort(&ptds[qp0[int(p)]], &ptds[qp[int(p)]], 
-      [] (const unique_ptr<drawqueueitem>& p1, const unique_ptr<drawqueueitem>& p2) {
-        return p1->subprio > p2->subprio;
-        });
-    }
+  sort_subpriorities();
+  sort_drawqueue_time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - sort_start).count();
 
 #if CAP_SDL
   if(current_display->stereo_active() && !vid.usingGL) {
@@ -84,6 +84,148 @@ EX set<int> snaketypes;
 EX int gamerange_bonus = 0;
 EX int gamerange() { return getDistLimit() + gamerange_bonus; }
 
+#if CAP_HOTCELLS
+/** A structure-of-arrays copy of the path distances of the cells in dcal. Updated at the end
+ *  of bfs(); pathdist is kept in sync by onpath() and clear_pathdata(). The BFS in computePathdist
+ *  uses it to reject already visited neighbors without touching their gcell.
+ *  Walls, monsters and lands are not mirrored, as they are changed all over the code.
+ *
+ *  A cell keeps its slot for as long as it stays in dcal, so after a move of the player
+ *  only the cells which have entered or left the game range need to be processed (see update()).
+ */
+EX namespace hot {
+  /** the cell in each slot, or nullptr for free slots */
+  EX vector<cell*> cells;
+  EX vector<short> pathdist;
+  /** neighbors of cells[i] in direction order are adj[adj_start[i] + j], for j < cells[i]->type; -1 if not in the table.
+   *  After update(), an entry may also point to a slot which is now used by another cell, so always compare with cells.
+   */
+  EX vector<int> adj_start, adj;
+
+  /** the length of the row of each slot in adj; it may be longer than the degree of the cell */
+  EX vector<short> row_size;
+
+  EX vector<int> free_slots;
+  /** the total length of the rows of all the slots; the other entries of adj are no longer used */
+  EX int live_adj;
+  /** the entries of adj for which the cell had no neighbor yet; the connection may be created later */
+  EX vector<pair<cell*, int>> unlinked;
+
+  /** false = rebuild the table from scratch in every bfs() */
+  EX bool incremental = true;
+
+  /** index of c in the table, or -1 */
+  EX int id(cell *c) {
+    int i = c->hotid - 1;
+    if(i < 0 || i >= isize(cells) || cells[i] != c) return -1;
+    return i;
+    }
+
+  EX void set_pathdist(cell *c, int d) {
+    int i = id(c);
+    if(i >= 0) pathdist[i] = d;
+    }
+
+  /** set the entry of cells[i] in direction j, and the entry of the neighbor in the opposite direction */
+  void link(int i, int j) {
+    cell *c = cells[i];
+    cell *c2 = c->move(j);
+    if(!c2) { adj[adj_start[i] + j] = -1; unlinked.emplace_back(c, j); return; }
+    int i2 = id(c2);
+    adj[adj_start[i] + j] = i2;
+    if(i2 < 0) return;
+    int j2 = c->c.spin(j);
+    if(c2->move(j2) == c) adj[adj_start[i2] + j2] = i;
+    }
+
+  EX void build() {
+    int N = isize(dcal);
+    cells = dcal;
+    free_slots.clear();
+    unlinked.clear();
+    pathdist.resize(N);
+    adj_start.resize(N);
+    row_size.resize(N);
+    int total = 0;
+    for(int i=0; i<N; i++) {
+      cell *c = cells[i];
+      c->hotid = i + 1;
+      pathdist[i] = c->pathdist;
+      adj_start[i] = total;
+      row_size[i] = c->type;
+      total += c->type;
+      }
+    adj.resize(total);
+    live_adj = total;
+    for(int i=0; i<N; i++)
+      for(int j=0; j<cells[i]->type; j++) link(i, j);
+    }
+
+  /** bring the table up to date with dcal: free the slots of the cells which are no longer
+   *  in dcal, and add the new cells, fixing the entries of their neighbors in adj
+   */
+  EX void update() {
+    if(!incremental || cells.empty()) { build(); return; }
+    int T = isize(cells);
+    vector<char> present(T, false);
+    vector<cell*> added;
+    for(cell *c: dcal) {
+      int i = id(c);
+      if(i >= 0) present[i] = true;
+      else added.push_back(c);
+      }
+
+    /* e.g. after a teleport */
+    if(isize(added) * 2 > isize(dcal)) { build(); return; }
+
+    for(int i=0; i<T; i++) if(cells[i] && !present[i]) {
+      cells[i] = nullptr;
+      free_slots.push_back(i);
+      }
+
+    for(cell *c: added) {
+      int i;
+      if(free_slots.empty()) {
+        i = isize(cells);
+        cells.push_back(c); pathdist.push_back(0); adj_start.push_back(0); row_size.push_back(0);
+        }
+      else {
+        i = free_slots.back(); free_slots.pop_back();
+        cells[i] = c;
+        }
+      c->hotid = i + 1;
+      pathdist[i] = c->pathdist;
+      if(row_size[i] < c->type) {
+        live_adj += c->type - row_size[i];
+        adj_start[i] = isize(adj);
+        row_size[i] = c->type;
+        adj.resize(isize(adj) + c->type);
+        }
+      }
+
+    /* the connections created since the last update */
+    vector<pair<cell*, int>> old_unlinked;
+    swap(old_unlinked, unlinked);
+    for(auto p: old_unlinked) {
+      int i = id(p.first);
+      if(i >= 0 && p.first->move(p.second)) link(i, p.second);
+      else if(i >= 0) unlinked.push_back(p);
+      }
+
+    for(cell *c: added)
+      for(int j=0; j<c->type; j++) link(c->hotid - 1, j);
+
+    /* rows which were too short to reuse */
+    if(isize(adj) > 2 * live_adj + 1024) build();
+    }
+
+  EX void forget() {
+    cells.clear(); pathdist.clear(); adj_start.clear(); row_size.clear(); adj.clear(); free_slots.clear(); unlinked.clear();
+    live_adj = 0;
+    }
+  EX }
+#endif
+
 // pathdist begin
 EX cell *pd_from;
 EX int pd_range;
@@ -91,6 +233,9 @@ EX int pd_range;
 EX void onpath(cell *c, int d) {
   if(!pathlock) { println(hlog, "onpath without pathlock"); }
   c->pathdist = d;
+  #if CAP_HOTCELLS
+  hot::set_pathdist(c, d);
+  #endif
   pathq.push_back(c);
   }
 
@@ -100,7 +245,12 @@ void onpath_rf(cell *c, int d, int sp) {
   }
 
 EX void clear_pathdata() {
-  for(auto c: pathq) c->pathdist = PINFD;
+  for(auto c: pathq) {
+    c->pathdist = PINFD;
+    #if CAP_HOTCELLS
+    hot::set_pathdist(c, PINFD);
+    #endif
+    }
   pathq.clear(); 
   pathqm.clear();
   }
@@ -117,6 +267,9 @@ EX void compute_graphical_distance() {
   pd_from = c1;
   pd_range = sr;
   c1->pathdist = 0;
+  #if CAP_HOTCELLS
+  hot::set_pathdist(c1, 0);
+  #endif
   pathq.push_back(pd_from);
   pathlock++;
 
@@ -205,11 +358,21 @@ EX void computePathdist(eMonster param, bool include_allies IS(true)) {
     if(c->cpdist > limit && !(c->land == laTrollheim && turncount < c->landparam) && c->wall != waThumperOn) continue;
     int d = c->pathdist;
     if(d == PINFD - 1) continue;
+    #if CAP_HOTCELLS
+    int hid = hot::id(c);
+    #endif
     for(int j=0; j<c->type; j++) {
       int i = (fd+j) % c->type; 
       // printf("i=%d cd=%d\n", i, c->move(i)->cpdist);
       cell *c2 = c->move(i);
       
+      #if CAP_HOTCELLS
+      if(hid >= 0 && !princess) {
+        int h2 = hot::adj[hot::adj_start[hid] + i];
+        if(h2 >= 0 && hot::cells[h2] == c2 && hot::pathdist[h2] != PINFD) continue;
+        }
+      #endif
+
       flagtype f = P_MONSTER | P_REVDIR;
       if(param == moTameBomberbird) f |= P_FLYING;
 
@@ -260,12 +423,114 @@ void pathdata::checklock() {
 
 pathdata::pathdata(int i) { checklock(); }
 
+/** The distance fields computed by computePathdist, kept so that a later pathdata of the same
+ *  passability class does not have to repeat the BFS.
+ *
+ *  Walls and monsters are changed directly all over the code, so the fields are only reused
+ *  in the scopes marked with pathcache::scope, where the caller makes sure that everything
+ *  which changes the map calls invalidate() first. moveMonster, attackMonster and killMonster
+ *  do this; bfs() does this too.
+ */
+EX namespace pathcache {
+  /** reuse the distance fields */
+  EX bool on = true;
+  /** also recompute the reused fields, and report the differences */
+  EX bool validate = false;
+  /** the fields are computed and reused only while this is positive */
+  EX int scope;
+
+  /** increased whenever the cached fields may be no longer valid */
+  EX int epoch;
+
+  #if HDR
+  struct field {
+    int cls;
+    vector<cell*> q, qm;
+    vector<short> dist;
+    /** the state of hrngen before computing the field (only with validate) */
+    shared_ptr<std::mt19937> rng;
+    };
+  #endif
+
+  /** the fields computed in the current epoch */
+  EX vector<field> fields;
+  EX int fields_epoch;
+
+  EX void invalidate() { epoch++; }
+
+  /** computePathdist gives the same field for all the monsters of the same class; -1 if it should not be cached */
+  EX int path_class(eMonster param, bool include_allies) {
+    if(isPrincess(param)) return -1;
+    int cls = include_allies ? 1 : 0;
+    if(param == moTameBomberbird) cls |= 2;
+    if(param == moTortoise) cls |= 4;
+    if(param == moIvyRoot) cls |= 8;
+    if(param == moWorm) cls |= 16;
+    if(!isFriendly(param) && items[itOrbLava]) cls |= 32;
+    return cls;
+    }
+
+  field *find(int cls) {
+    if(fields_epoch != epoch) { fields.clear(); fields_epoch = epoch; }
+    for(auto& f: fields) if(f.cls == cls) return &f;
+    return nullptr;
+    }
+
+  EX void forget() { fields.clear(); }
+
+  void store(int cls, const shared_ptr<std::mt19937>& rng) {
+    fields.emplace_back();
+    auto& f = fields.back();
+    f.cls = cls;
+    f.rng = rng;
+    f.q = pathq;
+    f.qm = pathqm;
+    for(cell *c: pathq) f.dist.push_back(c->pathdist);
+    }
+
+  void compare(field& f) {
+    map<cell*, int> old;
+    for(int i=0; i<isize(f.q); i++) old[f.q[i]] = f.dist[i];
+    int errors = 0;
+    for(cell *c: pathq) if(!old.count(c) || old[c] != c->pathdist) errors++;
+    if(isize(pathq) != isize(f.q) || set<cell*>(pathqm.begin(), pathqm.end()) != set<cell*>(f.qm.begin(), f.qm.end())) errors++;
+    if(errors) println(hlog, "pathcache: cached field of class ", f.cls, " is out of date (", errors, " errors)");
+    }
+
+  /** compute pathdist for pathdata(param, include_allies), or restore it */
+  EX void compute(eMonster param, bool include_allies) {
+    int cls = (on && scope) ? path_class(param, include_allies) : -1;
+    field *f = cls >= 0 ? find(cls) : nullptr;
+    if(!f) {
+      shared_ptr<std::mt19937> rng;
+      if(validate && cls >= 0) rng = make_shared<std::mt19937>(hrngen);
+      computePathdist(param, include_allies);
+      if(cls >= 0) store(cls, rng);
+      return;
+      }
+    /* the field depends on the random directions computePathdist starts from */
+    if(validate && f->rng) {
+      auto rng = hrngen;
+      hrngen = *f->rng;
+      computePathdist(param, include_allies);
+      compare(*f);
+      clear_pathdata();
+      hrngen = rng;
+      }
+    /* call hrand as computePathdist would, to keep the random numbers the same */
+    for(cell *c: targets)
+      if(include_allies || isPlayerOn(c)) hrand(c->type);
+    for(int i=0; i<isize(f->q); i++) onpath(f->q[i], f->dist[i]);
+    pathqm = f->qm;
+    }
+  EX }
+
 pathdata::pathdata(eMonster m, bool include_allies IS(true)) {
   checklock();
   if(isize(pathq))
     println(hlog, "! we got tiles on pathq: ", isize(pathq));
 
-  computePathdist(m, include_allies);
+  pathcache::compute(m, include_allies);
   }
 
 // pathdist end
@@ -279,7 +544,9 @@ EX vector<int> bfs_reachedfrom;
 
 /** calculate cpdist, 'have' flags, and do general fixings */
 EX void bfs() {
+  turn_timing::measure tm(turn_timing::ph_bfs);
 
+  pathcache::invalidate();
   calcTidalPhase(); 
     
   yendor::onpath();
@@ -533,6 +800,10 @@ EX void bfs() {
   for(auto& t: tempmonsters) t.first->monst = t.second;
   
   buildAirmap();
+
+  #if CAP_HOTCELLS
+  hot::update();
+  #endif
   }
 
 EX void moverefresh(bool turn IS(true)) {
@@ -809,6 +1080,7 @@ EX void findWormIvy(cell *c) {
   }
   
 EX void monstersTurn() {
+  turn_timing::measure tm(turn_timing::ph_monsters);
   checkSwitch();
   mirror::breakAll();
   DEBB(DF_TURN, ("bfs"));
@@ -109,6 +109,8 @@ struct gi_extension {
 
 struct expansion_analyzer;
 
+struct hstream;
+
 /** both for 'heptagon' 3D cells and subdivided 3D cells */
 struct subcellshape {
   /** \brief raw coordinates of vertices of all faces */
@@ -236,6 +238,7 @@ struct geometry_information {
   ld eyelevel_familiar, eyelevel_human, eyelevel_dog;
 
 #if CAP_SHAPES
+/* the hpcshape members from here to shReserved should be kept together, for_each_shape relies on this */
 hpcshape 
   shSemiFloorSide[SIDEPARS],
   shBFloor[2],
@@ -420,6 +423,11 @@ hpcshape
   void prepare_compute3();
   void prepare_shapes();
   void prepare_usershapes();
+  #if CAP_SHAPECACHE
+  void for_each_shape(const function<void(hpcshape&)>& f);
+  void serialize_shapes(hstream& hs, bool saving);
+  void clear_shapes();
+  #endif
 
   void hpcpush(hyperpoint h);
   void hpcsquare(hyperpoint h1, hyperpoint h2, hyperpoint h3, hyperpoint h4);
@@ -167,6 +167,18 @@ EX ld current_linewidth;
 
 GLuint buf_current, buf_buffered;
 
+#if CAP_INSTANCING
+/** use instanced drawing for runs of identical static shapes */
+EX bool instancing = true;
+/** does the current GL context support instanced arrays (OpenGL 3.3) */
+EX bool instancing_supported;
+/** persistent buffer for the static shapes, and a streamed buffer for per-instance matrices */
+GLuint buf_shapes, buf_instances;
+/** which vertex data is currently stored in buf_shapes */
+constvoidptr shapes_stored;
+int shapes_stored_size;
+#endif
+
 void display(const glmatrix& m) {
   for(int i=0; i<4; i++) {
     for(int j=0; j<4; j++)
@@ -402,6 +414,9 @@ GLprogram::GLprogram(string vsh, string fsh) {
   glBindAttribLocation(_program, aPosition, "aPosition");
   glBindAttribLocation(_program, aTexture, "aTexture");
   glBindAttribLocation(_program, aColor, "aColor");
+  #if CAP_INSTANCING
+  glBindAttribLocation(_program, aInstance, "aInstance");
+  #endif
 
   GLint status;
   glLinkProgram(_program);
@@ -617,6 +632,18 @@ EX void full_enable(shared_ptr<GLprogram> p) {
       GLERR("xsm");
       })
     }
+  #if CAP_INSTANCING
+  if(newflags & GF_INSTANCED) {
+    for(int c=0; c<4; c++)
+      glEnableVertexAttribArray(aInstance+c), glVertexAttribDivisor(aInstance+c, 1);
+    GLERR("instanced");
+    }
+  if(oldflags & GF_INSTANCED) {
+    for(int c=0; c<4; c++)
+      glVertexAttribDivisor(aInstance+c, 0), glDisableVertexAttribArray(aInstance+c);
+    GLERR("instanced");
+    }
+  #endif
   if(newflags & GF_LIGHTFOG) {
     #ifdef GLES_ONLY
     #define glFogi glFogx
@@ -725,6 +752,16 @@ void init() {
   buffered_vertices = (void*) &buffered_vertices; // point to nothing
   glBindBuffer(GL_ARRAY_BUFFER, buf_current);
   #endif
+
+  #if CAP_INSTANCING
+  glGenBuffers(1, &buf_shapes);
+  glGenBuffers(1, &buf_instances);
+  shapes_stored = nullptr;
+  int major = 0, minor = 0;
+  const char *ver = (const char*) glGetString(GL_VERSION);
+  if(ver) sscanf(ver, "%d.%d", &major, &minor);
+  instancing_supported = !noshaders && (major > 3 || (major == 3 && minor >= 3));
+  #endif
   }
 
 #if CAP_VERTEXBUFFER
@@ -882,7 +919,42 @@ EX void store_in_buffer(vector<glvertex>& v) {
   glBufferData(GL_ARRAY_BUFFER, isize(v) * sizeof(glvertex), &v[0], GL_STATIC_DRAW);
   printf("Stored.\n");
 #endif
+#if CAP_INSTANCING
+  shapes_stored = nullptr;
+#endif
+  }
+
+#if CAP_INSTANCING
+/** take the vertices from the persistent buffer holding v; v is uploaded only when it has changed */
+EX void shape_vertices(const vector<glvertex>& v) {
+  glBindBuffer(GL_ARRAY_BUFFER, buf_shapes);
+  if(shapes_stored != &v[0] || shapes_stored_size != isize(v)) {
+    glBufferData(GL_ARRAY_BUFFER, isize(v) * sizeof(glvertex), &v[0], GL_STATIC_DRAW);
+    shapes_stored = &v[0];
+    shapes_stored_size = isize(v);
+    }
+  glVertexAttribPointer(aPosition, SHDIM, GL_FLOAT, GL_FALSE, sizeof(glvertex), 0);
+  current_vertices = NULL;
+  }
+
+/** stream the per-instance model matrices, 16 floats each (see matrix_to_gl) */
+EX void instance_matrices(const vector<GLfloat>& m) {
+  glBindBuffer(GL_ARRAY_BUFFER, buf_instances);
+  glBufferData(GL_ARRAY_BUFFER, isize(m) * sizeof(GLfloat), &m[0], GL_STREAM_DRAW);
+  for(int c=0; c<4; c++)
+    glVertexAttribPointer(aInstance+c, 4, GL_FLOAT, GL_FALSE, 16 * sizeof(GLfloat), (void*) (c * 4 * sizeof(GLfloat)));
+  }
+
+/** return to the usual vertex arrays after instanced drawing */
+EX void end_instances() {
+  #if CAP_VERTEXBUFFER
+  glBindBuffer(GL_ARRAY_BUFFER, buf_current);
+  #else
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  #endif
+  current_vertices = NULL;
   }
+#endif
 
 EX void set_depthtest(bool b) {
   if(b != current_depthtest) {
@@ -5144,7 +5144,7 @@ EX void drawmovestar(double dx, double dy) {
 
 EX bool dronemode;
 
-purehookset hooks_calcparam;
+EX purehookset hooks_calcparam;
 
 EX int corner_centering;
 
@@ -421,6 +421,11 @@ EX namespace history {
     vector<SDL_Surface*> bands;
     
     resetbuffer rbuf;
+
+    /* finished segments are compressed and saved by the export threads, while the next ones are rendered */
+    #if CAP_SHOT && CAP_PNG
+    bool exporting = shot::start_export();
+    #endif
     
     if(1) {
       // block for RAII
@@ -443,12 +448,19 @@ EX namespace history {
         string fname = name_format;
         replace_str(fname, "$DATE", timebuf);
         replace_str(fname, "$ID", format("%03d", segid++));
-        IMAGESAVE(band, fname.c_str());
 
-        if(dospiral) 
+        if(dospiral) {
+          IMAGESAVE(band, fname.c_str());
           bands.push_back(band);
-        else 
+          }
+        else {
+          #if CAP_SHOT && CAP_PNG
+          shot::save_and_free(band, fname);
+          #else
+          IMAGESAVE(band, fname.c_str());
           SDL_FreeSurface(band);
+          #endif
+          }
         };
       
       if(!band) {
@@ -516,6 +528,10 @@ EX namespace history {
       save_band_segment();
       }
 
+    #if CAP_SHOT && CAP_PNG
+    if(exporting) shot::finish_export();
+    #endif
+
     rbuf.reset();
 
     if(includeHistory) restoreBack();
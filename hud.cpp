@@ -668,6 +668,7 @@ EX void drawStats() {
       vers = vers + " " + full_geometry_name();
     }
   if(!nofps) vers += XLAT(" fps: ") + its(calcfps());
+  if(!nofps && (debugflags & DF_GRAPH)) vers += " sort: " + its(sort_drawqueue_time) + " us";
   
   #if CAP_MEMORY_RESERVE
   if(reserve_limit && reserve_count < reserve_limit) {
@@ -27,6 +27,7 @@
 #include "glhr.cpp"
 #include "shaders.cpp"
 #include "raycaster.cpp"
+#include "raycpu.cpp"
 #include "hprint.cpp"
 #include "util.cpp"
 #include "hyperpoint.cpp"
@@ -82,6 +83,7 @@
 #include "3d-models.cpp"
 #include "floorshapes.cpp"
 #include "usershapes.cpp"
+#include "shapecache.cpp"
 #include "drawing.cpp"
 #include "mapeditor.cpp"
 #include "netgen.cpp"
@@ -220,6 +220,8 @@ typedef double ld;
 typedef long double ld;
 #define LDF "%Lf"
 #define PLDF "Lf"
+#undef CAP_SIMD
+#define CAP_SIMD 0
 #endif
 
 typedef complex<ld> cld;
@@ -479,6 +481,95 @@ template<class T> struct grow_vector : public vector<T> {
     }
   };
 
+inline uint64_t flat_key(uint64_t x) { return x; }
+template<class T> uint64_t flat_key(T* p) { return uintptr_t(p); }
+
+// open-addressing hash table from keys (pointers or integers) to int values;
+// each slot is stamped with the generation in which it was written, so clear()
+// just starts a new generation, and the storage is reused without being touched
+template<class K> struct flat_index {
+  struct slot {
+    K key;
+    int value;
+    unsigned gen;
+    };
+  vector<slot> slots;
+  unsigned gen;
+  int bits, qty;
+
+  flat_index() { gen = 1; bits = 0; qty = 0; }
+
+  int bucket(K k) const { return int((flat_key(k) * 0x9E3779B97F4A7C15ull) >> (64 - bits)); }
+
+  // the value for k, or -1 if not present
+  int find(K k) const {
+    if(!qty) return -1;
+    int mask = isize(slots) - 1;
+    for(int i = bucket(k);; i = (i+1) & mask) {
+      const slot& s = slots[i];
+      if(s.gen != gen) return -1;
+      if(s.key == k) return s.value;
+      }
+    }
+
+  // set the value for k to v, unless k is already present; returns true if it was not
+  bool insert(K k, int v) {
+    if(2 * (qty+1) > isize(slots)) rehash(bits ? bits+1 : 6);
+    int mask = isize(slots) - 1;
+    for(int i = bucket(k);; i = (i+1) & mask) {
+      slot& s = slots[i];
+      if(s.gen != gen) { s.key = k; s.value = v; s.gen = gen; qty++; return true; }
+      if(s.key == k) return false;
+      }
+    }
+
+  void rehash(int newbits) {
+    vector<slot> old;
+    old.swap(slots);
+    unsigned oldgen = gen;
+    bits = newbits; qty = 0; gen = 1;
+    slots.resize(1 << bits, slot{K(), 0, 0});
+    for(auto& s: old) if(s.gen == oldgen) insert(s.key, s.value);
+    }
+
+  void clear() {
+    qty = 0;
+    if(++gen == 0) {
+      for(auto& s: slots) s.gen = 0;
+      gen = 1;
+      }
+    }
+
+  int size() const { return qty; }
+  };
+
+template<class T> using ptr_index = flat_index<T*>;
+
+// a set with the interface of std::set used for 'visited' sets, based on flat_index
+template<class K> struct flat_set {
+  flat_index<K> index;
+  int count(K k) const { return index.find(k) >= 0; }
+  bool insert(K k) { return index.insert(k, 0); }
+  void clear() { index.clear(); }
+  int size() const { return index.size(); }
+  };
+
+// FIFO queue with the interface of std::queue, stored in a vector which is rewound
+// when drained, so that the memory is reused; references returned by front()
+// are invalidated by push/emplace
+template<class T> struct reusable_queue {
+  vector<T> data;
+  size_t head;
+  reusable_queue() { head = 0; }
+  bool empty() const { return head == data.size(); }
+  size_t size() const { return data.size() - head; }
+  T& front() { return data[head]; }
+  void push(const T& x) { data.push_back(x); }
+  template<class... U> void emplace(U&&... u) { data.emplace_back(std::forward<U>(u)...); }
+  void pop() { head++; if(head == data.size()) clear(); }
+  void clear() { data.clear(); head = 0; }
+  };
+
 // game forward declarations
 
 namespace anticheat { extern bool tampered; }
@@ -23,6 +23,164 @@ static const ld log_golden_phi = log(golden_phi);
 eGeometry geometry;
 eVariation variation;
 
+#if HDR
+#if CAP_SIMD
+/** \brief SIMD kernels for 4x4 matrices of doubles
+ *
+ *  These work on the full 4x4 array, and are thus used only when MXDIM == 4.
+ *  AVX is used if available (one register per row), otherwise SSE2 (two registers per row).
+ */
+namespace simd {
+
+#ifdef __AVX__
+struct row {
+  __m256d v;
+  };
+inline row load(const ld *p) { return row{_mm256_loadu_pd(p)}; }
+inline void store(ld *p, row r) { _mm256_storeu_pd(p, r.v); }
+inline row bcast(ld x) { return row{_mm256_set1_pd(x)}; }
+inline row make_row(ld a, ld b, ld c, ld d) { return row{_mm256_setr_pd(a, b, c, d)}; }
+inline row operator + (row a, row b) { return row{_mm256_add_pd(a.v, b.v)}; }
+inline row operator * (row a, row b) { return row{_mm256_mul_pd(a.v, b.v)}; }
+
+inline void transpose(row& r0, row& r1, row& r2, row& r3) {
+  __m256d t0 = _mm256_unpacklo_pd(r0.v, r1.v), t1 = _mm256_unpackhi_pd(r0.v, r1.v);
+  __m256d t2 = _mm256_unpacklo_pd(r2.v, r3.v), t3 = _mm256_unpackhi_pd(r2.v, r3.v);
+  r0.v = _mm256_permute2f128_pd(t0, t2, 0x20);
+  r1.v = _mm256_permute2f128_pd(t1, t3, 0x20);
+  r2.v = _mm256_permute2f128_pd(t0, t2, 0x31);
+  r3.v = _mm256_permute2f128_pd(t1, t3, 0x31);
+  }
+#else
+struct row {
+  __m128d lo, hi;
+  };
+inline row load(const ld *p) { return row{_mm_loadu_pd(p), _mm_loadu_pd(p+2)}; }
+inline void store(ld *p, row r) { _mm_storeu_pd(p, r.lo); _mm_storeu_pd(p+2, r.hi); }
+inline row bcast(ld x) { __m128d v = _mm_set1_pd(x); return row{v, v}; }
+inline row make_row(ld a, ld b, ld c, ld d) { return row{_mm_setr_pd(a, b), _mm_setr_pd(c, d)}; }
+inline row operator + (row a, row b) { return row{_mm_add_pd(a.lo, b.lo), _mm_add_pd(a.hi, b.hi)}; }
+inline row operator * (row a, row b) { return row{_mm_mul_pd(a.lo, b.lo), _mm_mul_pd(a.hi, b.hi)}; }
+
+inline void transpose(row& r0, row& r1, row& r2, row& r3) {
+  row c0{_mm_unpacklo_pd(r0.lo, r1.lo), _mm_unpacklo_pd(r2.lo, r3.lo)};
+  row c1{_mm_unpackhi_pd(r0.lo, r1.lo), _mm_unpackhi_pd(r2.lo, r3.lo)};
+  row c2{_mm_unpacklo_pd(r0.hi, r1.hi), _mm_unpacklo_pd(r2.hi, r3.hi)};
+  row c3{_mm_unpackhi_pd(r0.hi, r1.hi), _mm_unpackhi_pd(r2.hi, r3.hi)};
+  r0 = c0; r1 = c1; r2 = c2; r3 = c3;
+  }
+#endif
+
+/** R = A * B */
+inline void mul_mm(const ld *A, const ld *B, ld *R) {
+  row b0 = load(B), b1 = load(B+4), b2 = load(B+8), b3 = load(B+12);
+  for(int i=0; i<4; i++) {
+    const ld *a = A + 4*i;
+    store(R + 4*i, bcast(a[0]) * b0 + bcast(a[1]) * b1 + bcast(a[2]) * b2 + bcast(a[3]) * b3);
+    }
+  }
+
+/** r = A * h */
+inline void mul_mv(const ld *A, const ld *h, ld *r) {
+  row r0 = load(A), r1 = load(A+4), r2 = load(A+8), r3 = load(A+12);
+  transpose(r0, r1, r2, r3);
+  store(r, r0 * bcast(h[0]) + r1 * bcast(h[1]) + r2 * bcast(h[2]) + r3 * bcast(h[3]));
+  }
+
+/** R = transpose(A), with the first three rows multiplied by s012 and the last one by s3 */
+inline void transpose_signed(const ld *A, ld *R, row s012, row s3) {
+  row r0 = load(A), r1 = load(A+4), r2 = load(A+8), r3 = load(A+12);
+  transpose(r0, r1, r2, r3);
+  store(R, r0 * s012);
+  store(R+4, r1 * s012);
+  store(R+8, r2 * s012);
+  store(R+12, r3 * s3);
+  }
+
+/** Gauss-Jordan elimination on the 4x8 matrix [A|Id]; returns false if A is singular */
+inline bool inverse(const ld *A, ld *R) {
+  ld m[4][8];
+  ld *r[4];
+  for(int i=0; i<4; i++) {
+    store(m[i], load(A+4*i));
+    store(m[i]+4, make_row(i==0, i==1, i==2, i==3));
+    r[i] = m[i];
+    }
+  for(int a=0; a<4; a++) {
+    int best = a;
+    for(int b=a+1; b<4; b++)
+      if(std::abs(r[b][a]) > std::abs(r[best][a]))
+        best = b;
+    std::swap(r[a], r[best]);
+    if(!r[a][a]) return false;
+    ld inv = 1 / r[a][a];
+    row pa0 = load(r[a]), pa1 = load(r[a]+4);
+    for(int b=0; b<4; b++) if(b != a) {
+      row co = bcast(-r[b][a] * inv);
+      store(r[b], load(r[b]) + pa0 * co);
+      store(r[b]+4, load(r[b]+4) + pa1 * co);
+      }
+    }
+  for(int a=0; a<4; a++)
+    store(R+4*a, load(r[a]+4) * bcast(1 / r[a][a]));
+  return true;
+  }
+
+/** the matrix of ggpushxto0 for a point h in an isotropic 3D geometry */
+inline void gpush(const ld *h, ld fac, ld co, ld curv, ld *R) {
+  row w = make_row(fac * h[0], fac * h[1], fac * h[2], co);
+  for(int i=0; i<3; i++)
+    store(R+4*i, make_row(i==0, i==1, i==2, 0) + bcast(h[i]) * w);
+  store(R+12, make_row(h[0], h[1], h[2], 0) * bcast(-curv * co) + make_row(0, 0, 0, h[3]));
+  }
+}
+#endif
+
+/** \brief matrix computations with the dimension N known at compile time
+ *
+ *  The loops here have constant bounds, so they get fully unrolled. M is any type indexable
+ *  as M[i][j] (transmatrix or fixdim::transmatrix_t<N>), P is indexable as P[i].
+ *  The runtime API dispatches here on MXDIM/MDIM.
+ */
+namespace fixdim {
+
+template<int N, class M> inline void mul(const M& T, const M& U, M& R) {
+  for(int i=0; i<N; i++) for(int j=0; j<N; j++) {
+    ld s = 0;
+    for(int k=0; k<N; k++) s += T[i][k] * U[k][j];
+    R[i][j] = s;
+    }
+  }
+
+template<int N, class M, class P> inline void mul(const M& T, const P& H, P& R) {
+  for(int i=0; i<N; i++) {
+    ld s = 0;
+    for(int j=0; j<N; j++) s += T[i][j] * H[j];
+    R[i] = s;
+    }
+  }
+
+template<class M> inline ld det3(const M& T) {
+  ld det = 0;
+  for(int i=0; i<3; i++)
+    det += T[0][i] * T[1][(i+1)%3] * T[2][(i+2)%3];
+  for(int i=0; i<3; i++)
+    det -= T[0][i] * T[1][(i+2)%3] * T[2][(i+1)%3];
+  return det;
+  }
+
+/** inverse of the 3x3 part, using cofactors; returns false if singular */
+template<class M> inline bool inverse3(const M& T, M& R) {
+  ld d = det3(T);
+  if(d == 0) return false;
+  for(int i=0; i<3; i++)
+  for(int j=0; j<3; j++)
+    R[j][i] = (T[(i+1)%3][(j+1)%3] * T[(i+2)%3][(j+2)%3] - T[(i+1)%3][(j+2)%3] * T[(i+2)%3][(j+1)%3]) / d;
+  return true;
+  }
+}
+#endif
+
 
 #if HDR
 /** \brief A point in our continuous space
@@ -122,20 +280,21 @@ struct transmatrix {
   
   inline friend hyperpoint operator * (const transmatrix& T, const hyperpoint& H) {
     hyperpoint z;
-    for(int i=0; i<MXDIM; i++) {
-      z[i] = 0;
-      for(int j=0; j<MXDIM; j++) z[i] += T[i][j] * H[j];
-      }
+    #if CAP_SIMD
+    if(MXDIM == 4) { simd::mul_mv(T.tab[0], &H[0], &z[0]); return z; }
+    #endif
+    if(MXDIM == 3) fixdim::mul<3>(T, H, z);
+    else fixdim::mul<MAXMDIM>(T, H, z);
     return z;
     }
 
   inline friend transmatrix operator * (const transmatrix& T, const transmatrix& U) {
     transmatrix R;
-    for(int i=0; i<MXDIM; i++) for(int j=0; j<MXDIM; j++) {
-      R[i][j] = 0;
-      for(int k=0; k<MXDIM; k++)
-        R[i][j] += T[i][k] * U[k][j];
-      }
+    #if CAP_SIMD
+    if(MXDIM == 4) { simd::mul_mm(T.tab[0], U.tab[0], R.tab[0]); return R; }
+    #endif
+    if(MXDIM == 3) fixdim::mul<3>(T, U, R);
+    else fixdim::mul<MAXMDIM>(T, U, R);
     return R;
     }  
   };
@@ -226,6 +385,108 @@ constexpr hyperpoint C03 = hyperpoint(0,0,0,1);
 
 /** C0 is the origin in our space */
 #define C0 (MDIM == 3 ? C02 : C03)
+
+namespace fixdim {
+
+/** \brief a point with exactly N homogeneous coordinates */
+template<int N> struct hyperpoint_t : array<ld, N> {
+  hyperpoint_t() {}
+  explicit hyperpoint_t(const hyperpoint& h) { for(int i=0; i<N; i++) self[i] = h[i]; }
+  hyperpoint get() const { hyperpoint h = Hypc; for(int i=0; i<N; i++) h[i] = self[i]; return h; }
+  };
+
+/** \brief a NxN matrix acting on hyperpoint_t<N> */
+template<int N> struct transmatrix_t {
+  ld tab[N][N];
+  ld* operator [] (int i) { return tab[i]; }
+  const ld* operator [] (int i) const { return tab[i]; }
+  transmatrix_t() {}
+  explicit transmatrix_t(const transmatrix& T) { for(int i=0; i<N; i++) for(int j=0; j<N; j++) tab[i][j] = T[i][j]; }
+  transmatrix get() const { transmatrix T = Id; for(int i=0; i<N; i++) for(int j=0; j<N; j++) T[i][j] = tab[i][j]; return T; }
+
+  inline friend hyperpoint_t<N> operator * (const transmatrix_t& T, const hyperpoint_t<N>& H) {
+    hyperpoint_t<N> z; mul<N>(T, H, z); return z;
+    }
+  inline friend transmatrix_t operator * (const transmatrix_t& T, const transmatrix_t& U) {
+    transmatrix_t R; mul<N>(T, U, R); return R;
+    }
+  };
+
+/** sig(i) in the geometry class gc, for N homogeneous coordinates */
+template<eGeometryClass gc, int N> constexpr int sig(int i) {
+  return i < N-1 ? 1 : gc == gcEuclid ? 0 : gc == gcHyperbolic ? -1 : 1;
+  }
+
+/** intval in the geometry class gc (which should be gcHyperbolic, gcSphere or gcEuclid); does not handle the elliptic case */
+template<eGeometryClass gc, int N, class P> inline ld intval(const P& h1, const P& h2) {
+  ld res = 0;
+  for(int i=0; i<N; i++) res += (h1[i] - h2[i]) * (h1[i] - h2[i]) * sig<gc, N>(i);
+  return res;
+  }
+
+template<eGeometryClass gc, int N, class P> inline ld zlevel(const P& h) {
+  ld iv = 0;
+  for(int i=0; i<N; i++) iv += h[i] * h[i] * sig<gc, N>(i);
+  if(gc == gcEuclid) return h[N-1];
+  if(gc == gcSphere) return sqrt(iv);
+  return (h[N-1] < 0 ? -1 : 1) * sqrt(-iv);
+  }
+
+template<eGeometryClass gc, int N, class P> inline P normalize(P H) {
+  ld Z = zlevel<gc, N>(H);
+  for(int c=0; c<N; c++) H[c] /= Z;
+  return H;
+  }
+
+template<eGeometryClass gc, int N, class P> inline ld hdist0(const P& mh) {
+  if(gc == gcHyperbolic) return mh[N-1] < 1 ? 0 : acosh(mh[N-1]);
+  if(gc == gcSphere) return mh[N-1] >= 1 ? 0 : mh[N-1] <= -1 ? M_PI : acos(mh[N-1]);
+  ld sum = 0;
+  for(int i=0; i<N-1; i++) sum += mh[i] * mh[i];
+  return sqrt(sum);
+  }
+
+template<eGeometryClass gc, int N, class P> inline ld hdist(const P& h1, const P& h2) {
+  ld iv = intval<gc, N>(h1, h2);
+  if(gc == gcSphere) {
+    ld x = sqrt(iv) / 2;
+    return 2 * (x > 1 ? M_PI/2 : std::isnan(x) ? 0 : asin(x));
+    }
+  if(iv < 0) return 0;
+  if(gc == gcHyperbolic) return 2 * asinh(sqrt(iv) / 2);
+  return sqrt(iv);
+  }
+
+template<int N> inline hyperpoint tC0(const transmatrix& T) {
+  hyperpoint z;
+  for(int i=0; i<N; i++) z[i] = T[i][N-1];
+  return z;
+  }
+
+template<int N> inline hyperpoint_t<N> tC0(const transmatrix_t<N>& T) {
+  hyperpoint_t<N> z;
+  for(int i=0; i<N; i++) z[i] = T[i][N-1];
+  return z;
+  }
+
+/** inverse of an isometry in the geometry class gc */
+template<eGeometryClass gc, int N, class M> inline M iso_inverse(const M& T) {
+  M U = T;
+  for(int i=0; i<N; i++) for(int j=0; j<N; j++) U[i][j] = T[j][i];
+  if(gc == gcHyperbolic) for(int i=0; i<N-1; i++)
+    U[i][N-1] = -U[i][N-1], U[N-1][i] = -U[N-1][i];
+  if(gc == gcEuclid) {
+    for(int i=0; i<N-1; i++) {
+      ld s = 0;
+      for(int j=0; j<N-1; j++) s += U[i][j] * T[j][N-1];
+      U[i][N-1] = -s;
+      U[N-1][i] = 0;
+      }
+    U[N-1][N-1] = 1;
+    }
+  return U;
+  }
+}
 #endif
 
 // basic functions and types
@@ -413,6 +674,12 @@ EX bool zero_d(int d, hyperpoint h) {
  */
 
 EX ld intval(const hyperpoint &h1, const hyperpoint &h2) {
+  if(!elliptic) switch(cgclass) {
+    case gcHyperbolic: return MDIM == 3 ? fixdim::intval<gcHyperbolic, 3>(h1, h2) : fixdim::intval<gcHyperbolic, MAXMDIM>(h1, h2);
+    case gcSphere: return MDIM == 3 ? fixdim::intval<gcSphere, 3>(h1, h2) : fixdim::intval<gcSphere, MAXMDIM>(h1, h2);
+    case gcEuclid: return MDIM == 3 ? fixdim::intval<gcEuclid, 3>(h1, h2) : fixdim::intval<gcEuclid, MAXMDIM>(h1, h2);
+    default: break;
+    }
   ld res = 0;
   for(int i=0; i<MDIM; i++) res += squar(h1[i] - h2[i]) * sig(i);
   if(elliptic) {
@@ -497,6 +764,12 @@ EX ld hypot_auto(ld x, ld y) {
 /** normalize the homogeneous coordinates */
 EX hyperpoint normalize(hyperpoint H) {
   if(prod) return H;
+  if(MDIM == 3) switch(cgclass) {
+    case gcHyperbolic: return fixdim::normalize<gcHyperbolic, 3>(H);
+    case gcSphere: return fixdim::normalize<gcSphere, 3>(H);
+    case gcEuclid: return fixdim::normalize<gcEuclid, 3>(H);
+    default: break;
+    }
   ld Z = zlevel(H);
   for(int c=0; c<MXDIM; c++) H[c] /= Z;
   return H;
@@ -855,6 +1128,12 @@ EX transmatrix ggpushxto0(const hyperpoint& H, ld co) {
   transmatrix res = Id;
   if(sqhypot_d(GDIM, H) < 1e-16) return res;
   ld fac = -curvature()/(H[LDIM]+1);
+  #if CAP_SIMD
+  if(MDIM == 4 && GDIM == 3) {
+    simd::gpush(&H[0], fac, co, curvature(), res.tab[0]);
+    return res;
+    }
+  #endif
   for(int i=0; i<GDIM; i++)
   for(int j=0; j<GDIM; j++)
     res[i][j] += H[i] * H[j] * fac;
@@ -984,16 +1263,11 @@ void inverse_error(const transmatrix& T) {
 
 /** inverse of a 3x3 matrix */
 EX transmatrix inverse3(const transmatrix& T) {
-  ld d = det(T);
   transmatrix T2;
-  if(d == 0) {
+  if(!fixdim::inverse3(T, T2)) {
     inverse_error(T); 
     return Id;
     }
-  
-  for(int i=0; i<3; i++) 
-  for(int j=0; j<3; j++) 
-    T2[j][i] = (T[(i+1)%3][(j+1)%3] * T[(i+2)%3][(j+2)%3] - T[(i+1)%3][(j+2)%3] * T[(i+2)%3][(j+1)%3]) / d;
   return T2;
   }
 
@@ -1001,6 +1275,13 @@ EX transmatrix inverse3(const transmatrix& T) {
 EX transmatrix inverse(const transmatrix& T) {
   if(MDIM == 3) 
     return inverse3(T);
+  #if CAP_SIMD
+  else if(GDIM == 3) {
+    transmatrix T2;
+    if(!simd::inverse(T.tab[0], T2.tab[0])) { inverse_error(T); return Id; }
+    return T2;
+    }
+  #endif
   else {
     transmatrix T1 = T;
     transmatrix T2 = Id;
@@ -1039,6 +1320,13 @@ EX transmatrix inverse(const transmatrix& T) {
 
 /** \brief inverse of an orthogonal matrix, i.e., transposition */
 EX transmatrix ortho_inverse(transmatrix T) {
+  #if CAP_SIMD
+  if(MDIM == 4) {
+    transmatrix R;
+    simd::transpose_signed(T.tab[0], R.tab[0], simd::bcast(1), simd::bcast(1));
+    return R;
+    }
+  #endif
   for(int i=1; i<MDIM; i++)
     for(int j=0; j<i; j++)
       swap(T[i][j], T[j][i]);
@@ -1047,6 +1335,13 @@ EX transmatrix ortho_inverse(transmatrix T) {
 
 /** \brief inverse of an orthogonal matrix in Minkowski space */
 EX transmatrix pseudo_ortho_inverse(transmatrix T) {
+  #if CAP_SIMD
+  if(MDIM == 4) {
+    transmatrix R;
+    simd::transpose_signed(T.tab[0], R.tab[0], simd::make_row(1, 1, 1, -1), simd::make_row(-1, -1, -1, 1));
+    return R;
+    }
+  #endif
   for(int i=1; i<MXDIM; i++)
     for(int j=0; j<i; j++)
       swap(T[i][j], T[j][i]);
@@ -1058,6 +1353,11 @@ EX transmatrix pseudo_ortho_inverse(transmatrix T) {
 
 /** \brief inverse of an isometry -- in most geometries this can be done more efficiently than using inverse */
 EX transmatrix iso_inverse(const transmatrix& T) {
+  if(MXDIM == 3) {
+    if(hyperbolic) return fixdim::iso_inverse<gcHyperbolic, 3>(T);
+    if(sphere) return fixdim::iso_inverse<gcSphere, 3>(T);
+    if(euclid && !(cgflags & qAFFINE)) return fixdim::iso_inverse<gcEuclid, 3>(T);
+    }
   if(hyperbolic)
     return pseudo_ortho_inverse(T);
   if(sphere) 
@@ -1159,6 +1459,12 @@ EX ld circlelength(ld r) {
 
 /* distance between h1 and h2 */
 EX ld hdist(const hyperpoint& h1, const hyperpoint& h2) {
+  if(MDIM == 3 && !elliptic) switch(cgclass) {
+    case gcHyperbolic: return fixdim::hdist<gcHyperbolic, 3>(h1, h2);
+    case gcSphere: return fixdim::hdist<gcSphere, 3>(h1, h2);
+    case gcEuclid: return fixdim::hdist<gcEuclid, 3>(h1, h2);
+    default: break;
+    }
   ld iv = intval(h1, h2);
   switch(cgclass) {
     case gcEuclid:
@@ -1414,6 +1720,7 @@ inline hyperpoint zpush0(ld x) { return cpush0(2, x); }
 
 /** T * C0, optimized */
 inline hyperpoint tC0(const transmatrix &T) {
+  if(MXDIM == 3) return fixdim::tC0<3>(T);
   hyperpoint z;
   for(int i=0; i<MXDIM; i++) z[i] = T[i][LDIM];
   return z;
@@ -1490,6 +1797,48 @@ EX hyperpoint inverse_exp(const shiftpoint h, flagtype prec IS(pNORMAL)) {
   return v;
   }
 
+/** the number of threads used by inverse_exp_array for large arrays (-1 = hardware concurrency) */
+EX int inverse_exp_threads = 1;
+
+void inverse_exp_block(const shiftpoint *h, hyperpoint *res, int qty, flagtype prec) {
+  #if CAP_SOLV
+  if(sn::in()) { sn::get_inverse_exp_array(h, res, qty, prec); return; }
+  #endif
+  if(nil) { nilv::get_inverse_exp_array(h, res, qty, prec); return; }
+  for(int i=0; i<qty; i++) res[i] = inverse_exp(h[i], prec);
+  }
+
+/** inverse_exp for qty points at once: res[i] = inverse_exp(h[i], prec)
+ *  In Solv and Nil the work for consecutive points is interleaved, and large arrays are split between inverse_exp_threads threads.
+ */
+EX void inverse_exp_array(const shiftpoint *h, hyperpoint *res, int qty, flagtype prec IS(pNORMAL)) {
+  #if CAP_SOLV
+  /* make sure that the table is loaded before the threads start */
+  if(sn::in()) sn::get_tabled();
+  #endif
+  #if CAP_THREAD
+  int threads = inverse_exp_threads;
+  if(threads < 0) threads = std::thread::hardware_concurrency();
+  const int chunk = 1024;
+  if(threads > 1 && qty >= 2 * chunk) {
+    std::atomic<int> next(0);
+    auto work = [&] {
+      while(true) {
+        int from = next.fetch_add(chunk);
+        if(from >= qty) return;
+        inverse_exp_block(h + from, res + from, min(chunk, qty - from), prec);
+        }
+      };
+    vector<std::thread> workers;
+    for(int k=1; k<threads; k++) workers.emplace_back(work);
+    work();
+    for(auto& w: workers) w.join();
+    return;
+    }
+  #endif
+  inverse_exp_block(h, res, qty, prec);
+  }
+
 EX ld geo_dist(const hyperpoint h1, const hyperpoint h2, flagtype prec IS(pNORMAL)) {
   if(!nonisotropic) return hdist(h1, h2);
   return hypot_d(3, inverse_exp(shiftless(nisot::translate(h1, -1) * h2, prec)));
@@ -1704,6 +1704,10 @@ void hrmap::draw_all() {
   }
 
 void hrmap::draw_at(cell *at, const shiftmatrix& where) {
+  if(dq::relative_usable()) {
+    dq::draw_relative(this, at, where);
+    return;
+    }
   dq::clear_all();
   auto& enq = confusingGeometry() ? dq::enqueue_by_matrix_c : dq::enqueue_c;
   
@@ -2701,20 +2705,20 @@ EX shiftmatrix optimized_shift(const shiftmatrix& T) {
   }
 
 EX namespace dq {
-  EX queue<pair<heptagon*, shiftmatrix>> drawqueue;
+  EX reusable_queue<pair<heptagon*, shiftmatrix>> drawqueue;
   
   EX unsigned bucketer(const shiftpoint& T) {
     return bucketer(T.h) + unsigned(floor(T.shift*81527+.5));
     }
 
-  EX set<heptagon*> visited;
+  EX flat_set<heptagon*> visited;
   EX void enqueue(heptagon *h, const shiftmatrix& T) {
     if(!h || visited.count(h)) { return; }
     visited.insert(h);
     drawqueue.emplace(h, T);
     }  
 
-  EX set<unsigned> visited_by_matrix;
+  EX flat_set<unsigned> visited_by_matrix;
   EX void enqueue_by_matrix(heptagon *h, const shiftmatrix& T) {
     if(!h) return;
     unsigned b = bucketer(tC0(T));
@@ -2723,8 +2727,8 @@ EX namespace dq {
     drawqueue.emplace(h, T);
     }
 
-  EX queue<pair<cell*, shiftmatrix>> drawqueue_c;
-  EX set<cell*> visited_c;
+  EX reusable_queue<pair<cell*, shiftmatrix>> drawqueue_c;
+  EX flat_set<cell*> visited_c;
 
   EX void enqueue_c(cell *c, const shiftmatrix& T) {
     if(!c || visited_c.count(c)) { return; }
@@ -2744,8 +2748,156 @@ EX namespace dq {
     visited.clear();
     visited_by_matrix.clear();
     visited_c.clear();
-    while(!drawqueue_c.empty()) drawqueue_c.pop();
-    while(!drawqueue.empty()) drawqueue.pop();
+    drawqueue_c.clear();
+    drawqueue.clear();
+    }
+
+  /** hrmap::draw_at remembers the cells reached from the center cell, together
+   *  with their matrices relative to it. While the center does not change, the next
+   *  frames traverse the same graph and get each matrix by one multiplication with
+   *  the new view, instead of calling adj() for every neighbor of every drawn cell.
+   *  The relative matrices do not depend on the view, so no error accumulates
+   *  between frames.
+   */
+  EX bool relative_cache = true;
+
+  /** forget the cache when it grows beyond this many cells */
+  EX int relative_cache_limit = 1000000;
+
+  struct relative_cell {
+    cell *c;
+    transmatrix R;
+    /** neighbors are rel_neighbors[nei..nei+c->type), -1 if not yet known */
+    int nei;
+    /** the frame in which this cell has been enqueued */
+    unsigned stamp;
+    };
+
+  vector<relative_cell> rel_cells;
+  vector<int> rel_neighbors;
+  ptr_index<cell> rel_index;
+  reusable_queue<int> rel_queue;
+  unsigned rel_stamp;
+
+  /** with draw_threads > 1, the matrices and range_3d of all the known cells are
+   *  computed in parallel before the traversal; drawcell itself stays on the main
+   *  thread, since it modifies the game state and the drawing queue */
+  EX int draw_threads = 1;
+
+  vector<shiftmatrix> rel_V;
+  vector<char> rel_range;
+
+  void precompute_relative(const shiftmatrix& where, int qty) {
+    rel_V.resize(qty);
+    rel_range.resize(qty);
+    #if CAP_THREAD
+    const int chunk = 64;
+    std::atomic<int> next(0);
+    auto work = [&] {
+      while(true) {
+        int from = next.fetch_add(chunk);
+        if(from >= qty) return;
+        int to = min(from + chunk, qty);
+        for(int i=from; i<to; i++) {
+          rel_V[i] = where * rel_cells[i].R;
+          rel_range[i] = range_3d(rel_V[i]);
+          }
+        }
+      };
+    vector<std::thread> workers;
+    for(int k=1; k<draw_threads; k++) workers.emplace_back(work);
+    work();
+    for(auto& w: workers) w.join();
+    #endif
+    }
+
+  cell *rel_center;
+  unsigned rel_center_serial;
+  hrmap *rel_map;
+  geometry_information *rel_cgi;
+
+  EX void forget_relative() {
+    rel_cells.clear();
+    rel_neighbors.clear();
+    rel_index.clear();
+    rel_queue.clear();
+    rel_center = nullptr;
+    }
+
+  /** matrices are reusable only if optimize_shift would not change them */
+  EX bool relative_usable() {
+    if(!relative_cache || confusingGeometry() || sl2) return false;
+    if((mdinf[pmodel].flags & mf::uses_bandshift) || (sphere && pmodel == mdSpiral)) return false;
+    #if MAXMDIM >= 4
+    if(reg3::ultra_mirror_in()) return false;
+    #endif
+    return true;
+    }
+
+  int relative_id(cell *c, const transmatrix& R) {
+    int id = isize(rel_cells);
+    if(!rel_index.insert(c, id)) return rel_index.find(c);
+    rel_cells.push_back(relative_cell{c, R, -1, 0});
+    return id;
+    }
+
+  /** same traversal as hrmap::draw_at, with the adj() results taken from the cache */
+  EX void draw_relative(hrmap *m, cell *at, const shiftmatrix& where) {
+    if(at != rel_center || at->serial != rel_center_serial || m != rel_map || &cgi != rel_cgi || isize(rel_cells) > relative_cache_limit) {
+      forget_relative();
+      rel_center = at; rel_center_serial = at->serial;
+      rel_map = m; rel_cgi = &cgi;
+      }
+    if(rel_cells.empty()) relative_id(at, Id);
+
+    if(++rel_stamp == 0) {
+      for(auto& rc: rel_cells) rc.stamp = 0;
+      rel_stamp = 1;
+      }
+
+    int precomputed = 0;
+    if(CAP_THREAD && WDIM == 3 && draw_threads > 1 && isize(rel_cells) >= 256) {
+      precomputed = isize(rel_cells);
+      precompute_relative(where, precomputed);
+      }
+
+    rel_queue.clear();
+    rel_cells[0].stamp = rel_stamp;
+    rel_queue.push(0);
+
+    while(!rel_queue.empty()) {
+      int id = rel_queue.front();
+      rel_queue.pop();
+      cell *c = rel_cells[id].c;
+      shiftmatrix V;
+      if(id < precomputed) {
+        V = rel_V[id];
+        if(!do_draw_3d(c, V, rel_range[id])) continue;
+        }
+      else {
+        V = where * rel_cells[id].R;
+        if(!do_draw(c, V)) continue;
+        }
+      drawcell(c, V);
+      if(in_wallopt() && isWall3(c) && isize(dq::drawqueue) > 1000) continue;
+
+      if(rel_cells[id].nei == -1) {
+        int nei = isize(rel_neighbors);
+        for(int i=0; i<c->type; i++) {
+          cell *c1 = c->cmove(i);
+          rel_neighbors.push_back(c1 == &out_of_bounds ? -1 : relative_id(c1, rel_cells[id].R * m->adj(c, i)));
+          }
+        rel_cells[id].nei = nei;
+        }
+
+      int nei = rel_cells[id].nei;
+      for(int i=0; i<c->type; i++) {
+        int id1 = rel_neighbors[nei+i];
+        if(id1 == -1 || rel_cells[id1].stamp == rel_stamp) continue;
+        rel_cells[id1].stamp = rel_stamp;
+        rel_queue.push(id1);
+        }
+      }
     }
 
 
@@ -2774,47 +2926,57 @@ bool limited_generation(cell *c) {
   return true;
   }
 
-EX bool do_draw(cell *c, const shiftmatrix& T) {
+/** the part of do_draw in 3D which depends only on T (and thus can be computed
+ *  in parallel): 0 if out of range, 2 if in range and the cell should be generated,
+ *  1 if in range but too far to generate */
+EX int range_3d(const shiftmatrix& T) {
+  #if MAXMDIM >= 4
+  if(nil && pmodel == mdGeodesic) {
+    ld dist = hypot_d(3, inverse_exp(tC0(T), pQUICK));
+    if(dist > sightranges[geometry] + (vid.sloppy_3d ? 0 : 0.9)) return 0;
+    return dist <= extra_generation_distance ? 2 : 1;
+    }
+  else if(pmodel == mdGeodesic && sol) {
+    return nisot::in_table_range(tC0(T.T)) ? 2 : 0;
+    }
+  else if(pmodel == mdGeodesic && nih) {
+    hyperpoint h = inverse_exp(tC0(T), pQUICK);
+    ld dist = hypot_d(3, h);
+    if(dist > sightranges[geometry] + (vid.sloppy_3d ? 0 : cgi.corner_bonus)) return 0;
+    return dist <= extra_generation_distance ? 2 : 1;
+    }
+  else if(pmodel == mdGeodesic && sl2) {
+    if(hypot(tC0(T.T)[2], tC0(T.T)[3]) > cosh(slr::range_xy)) return 0;
+    if(abs(T.shift * stretch::not_squared()) > sightranges[geometry]) return 0;
+    return 2;
+    }
+  #endif
+  else if(vid.use_smart_range) {
+    return in_smart_range(T) ? 2 : 0;
+    }
+  else {
+    ld dist = hdist0(tC0(T.T));
+    if(dist > sightranges[geometry] + (vid.sloppy_3d ? 0 : cgi.corner_bonus)) return 0;
+    return dist <= extra_generation_distance ? 2 : 1;
+    }
+  }
 
-  if(WDIM == 3) {
-    // do not care about cells outside of the track
-    if(GDIM == 3 && racing::on && c->land == laMemory && cells_drawn >= S7+1) return false;
+/** do_draw for WDIM == 3; range is the result of range_3d(T), or -1 if not computed yet */
+EX bool do_draw_3d(cell *c, const shiftmatrix& T, int range) {
+  // do not care about cells outside of the track
+  if(GDIM == 3 && racing::on && c->land == laMemory && cells_drawn >= S7+1) return false;
 
-    if(cells_drawn > vid.cells_drawn_limit) return false;
-    if(cells_drawn < 50) { limited_generation(c); return true; }
-    #if MAXMDIM >= 4
-    if(nil && pmodel == mdGeodesic) {
-      ld dist = hypot_d(3, inverse_exp(tC0(T), pQUICK));
-      if(dist > sightranges[geometry] + (vid.sloppy_3d ? 0 : 0.9)) return false;
-      if(dist <= extra_generation_distance && !limited_generation(c)) return false;
-      }
-    else if(pmodel == mdGeodesic && sol) {
-      if(!nisot::in_table_range(tC0(T.T))) return false;
-      if(!limited_generation(c)) return false;
-      }
-    else if(pmodel == mdGeodesic && nih) {
-      hyperpoint h = inverse_exp(tC0(T), pQUICK);
-      ld dist = hypot_d(3, h);
-      if(dist > sightranges[geometry] + (vid.sloppy_3d ? 0 : cgi.corner_bonus)) return false;
-      if(dist <= extra_generation_distance && !limited_generation(c)) return false;
-      }
-    else if(pmodel == mdGeodesic && sl2) {
-      if(hypot(tC0(T.T)[2], tC0(T.T)[3]) > cosh(slr::range_xy)) return false;     
-      if(abs(T.shift * stretch::not_squared()) > sightranges[geometry]) return false;
-      if(!limited_generation(c)) return false;
-      }
-    #endif
-    else if(vid.use_smart_range) {
-      if(cells_drawn >= 50 && !in_smart_range(T)) return false;
-      if(!limited_generation(c)) return false;
-      }
-    else {
-      ld dist = hdist0(tC0(T.T));
-      if(dist > sightranges[geometry] + (vid.sloppy_3d ? 0 : cgi.corner_bonus)) return false;
-      if(dist <= extra_generation_distance && !limited_generation(c)) return false;
-      }
-    return true;
-    }
+  if(cells_drawn > vid.cells_drawn_limit) return false;
+  if(cells_drawn < 50) { limited_generation(c); return true; }
+  if(range == -1) range = range_3d(T);
+  if(range == 0) return false;
+  if(range == 2 && !limited_generation(c)) return false;
+  return true;
+  }
+
+EX bool do_draw(cell *c, const shiftmatrix& T) {
+
+  if(WDIM == 3) return do_draw_3d(c, T, -1);
 
   #if MAXMDIM >= 4
   if(rots::drawing_underlying && euclid && hdist0(tC0(T)) > 6) return false;
@@ -2892,6 +2892,7 @@ EX hookset<bool(cell *c, int d, cell *from)> hooks_cellgen;
 EX void setdist(cell *c, int d, cell *from) {
 
   if(c == &out_of_bounds) return;
+  turn_timing::measure tm(turn_timing::ph_setdist);
   if(fake::in()) return FPIU(setdist(c, d, from));
   
   if(c->mpdist <= d) return;
@@ -98,10 +98,22 @@ struct gcell {
   int cellid;
   #endif
   
+  /** \brief unique serial number assigned by newCell, used by indexed_celllister; the only cell not created by newCell is out_of_bounds, with serial 0 */
+  unsigned serial;
+
+  #if CAP_HOTCELLS
+  /** \brief 1 + index in hot::cells, or 0; only valid if hot::cells agrees */
+  int hotid;
+  #endif
+  
   gcell() {
     #ifdef CELLID
     cellid = cellcount;  
     #endif
+    serial = 0;
+    #if CAP_HOTCELLS
+    hotid = 0;
+    #endif
     }
   };
 
@@ -121,7 +133,7 @@ template<class T> struct walker;
  *  we are connected to, as well as the index of this edge in the other T, and whether it is 
  *  mirrored (for graphs on non-orientable manifolds).
  *  To conserve memory, these classes need to be allocated with tailored_alloc
- *  and freed with tailored_free.
+ *  and freed with tailored_delete.
  */
 
 int gmod(int i, int j);
@@ -177,11 +189,18 @@ template<class T> struct connection_table {
  * RAM, so we really need to be careful on low memory devices. 
  */
 
+void *slab_alloc(int bytes);
+void slab_free(void *p);
+
 template<class T> T* tailored_alloc(int degree) {
   T* result;
 #ifndef NO_TAILORED_ALLOC
   int b = offsetof(T, c) + offsetof(connection_table<T>, move_table) + sizeof(T*) * degree + degree;
+  #if CAP_SLAB
+  result = (T*) slab_alloc(b);
+  #else
   result = (T*) new char[b];
+  #endif
   new (result) T();
 #else
   result = new T;
@@ -194,7 +213,11 @@ template<class T> T* tailored_alloc(int degree) {
 /** \brief Counterpart to hr::tailored_alloc(). */
 template<class T> void tailored_delete(T* x) {
   x->~T();  
+#if CAP_SLAB && !defined(NO_TAILORED_ALLOC)
+  slab_free(x);
+#else
   delete[] ((char*) (x));
+#endif
   }
 
 static const struct wstep_t { wstep_t() {} } wstep;
@@ -416,9 +439,100 @@ struct manual_celllister {
     for(int i=0; i<isize(lst); i++) lst[i]->listindex = tmps[i];
     }  
   };
+
+/** \brief Like manual_celllister, but the indices are kept in the lister, keyed by gcell::serial.
+  *
+  * The cells are not modified, so there is no restoring pass on destruction, and any number
+  * of these may be active at once, in any order, and on different threads.
+  *
+  * The serials of the cells of a region are usually close to each other, so the
+  * indices are stored in pages of consecutive serials. As in manual_celllister, an entry
+  * is only trusted if lst agrees, so neither clear() nor a new lister needs to reset the pages;
+  * they are recycled through a per-thread pool.
+  */
+struct indexed_celllister {
+  /** \brief list of cells in this list */
+  vector<cell*> lst;
+
+  static const int page_bits = 9;
+  static const int page_size = 1 << page_bits;
+  /** \brief pages[i][j] is 1 + the index of the cell with serial ((first_page+i) << page_bits) + j, or nullptr */
+  vector<int*> pages;
+  unsigned first_page;
+
+  static const int max_pooled = 256;
+  struct page_pool_t {
+    vector<int*> pages;
+    ~page_pool_t() { for(int *pg: pages) delete[] pg; }
+    };
+  static vector<int*>& page_pool() { static thread_local page_pool_t pool; return pool.pages; }
+
+  indexed_celllister() { first_page = 0; }
+  indexed_celllister(const indexed_celllister&) = delete;
+  indexed_celllister& operator=(const indexed_celllister&) = delete;
+
+  ~indexed_celllister() {
+    auto& pool = page_pool();
+    for(int *pg: pages) if(pg) {
+      if(isize(pool) < max_pooled) pool.push_back(pg);
+      else delete[] pg;
+      }
+    }
+
+  /** \brief the entry for c, or nullptr if its page has not been set up */
+  int *find_entry(cell *c) {
+    unsigned i = (c->serial >> page_bits) - first_page;
+    if(i >= pages.size() || !pages[i]) return nullptr;
+    return pages[i] + (c->serial & (page_size - 1));
+    }
+
+  /** \brief set up the page for c, and return its entry */
+  int *new_entry(cell *c) {
+    unsigned p = c->serial >> page_bits;
+    if(pages.empty()) first_page = p;
+    if(p < first_page) {
+      pages.insert(pages.begin(), first_page - p, nullptr);
+      first_page = p;
+      }
+    if(p - first_page >= pages.size()) pages.resize(p - first_page + 1, nullptr);
+    int*& pg = pages[p - first_page];
+    auto& pool = page_pool();
+    if(pool.empty()) pg = new int[page_size]();
+    else { pg = pool.back(); pool.pop_back(); }
+    return pg + (c->serial & (page_size - 1));
+    }
+
+  /** \brief is e a valid entry for c? */
+  bool valid(cell *c, int *e) {
+    unsigned i = *e - 1;
+    return i < unsigned(isize(lst)) && lst[i] == c;
+    }
+
+  /** \brief position of c on the list, or -1 */
+  int get_index(cell *c) {
+    int *e = find_entry(c);
+    return e && valid(c, e) ? *e - 1 : -1;
+    }
+
+  /** \brief is the given cell on the list? */
+  bool listed(cell *c) { return get_index(c) >= 0; }
+
+  /** \brief add a cell to the list */
+  bool add(cell *c) {
+    int *e = find_entry(c);
+    if(!e) e = new_entry(c);
+    else if(valid(c, e)) return false;
+    *e = isize(lst) + 1;
+    lst.push_back(c);
+    return true;
+    }
+
+  /** \brief empty the list, keeping the pages */
+  void clear() { lst.clear(); }
+  };
   
 /** \brief automatically generate a list of nearby cells */
-struct celllister : manual_celllister {
+struct celllister : indexed_celllister {
   vector<int> dists;
   
   void add_at(cell *c, int d) {
@@ -448,7 +562,7 @@ struct celllister : manual_celllister {
     }
   
   /** \brief for a given cell c on the list, return its distance from orig */
-  int getdist(cell *c) { return dists[c->listindex]; }
+  int getdist(cell *c) { return dists[get_index(c)]; }
   };
 
 /** \brief translate heptspins to cellwalkers and vice versa */
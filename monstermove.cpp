@@ -129,6 +129,7 @@ EX void moveMonster(const movei& mi) {
   auto& cf = mi.s;
   auto& ct = mi.t;
   eMonster m = cf->monst;
+  pathcache::invalidate();
   changes.ccell(cf);
   changes.ccell(ct);
   bool fri = isFriendly(cf);
@@ -1675,6 +1676,9 @@ EX void movegolems(flagtype flags) {
   if(items[itOrbEmpathy] && items[itOrbSlaying])
     flags |= AF_CRUSH;
   int qg = 0;
+  /* the golems which do not act (e.g. stunned ones) leave the map unchanged, so the next golems can reuse their distance fields */
+  pathcache::invalidate();
+  dynamicval<int> pcs(pathcache::scope, pathcache::scope + 1);
   for(int i=0; i<isize(golems); i++) {
     cell *c = golems[i];
     eMonster m = c->monst;
@@ -57,6 +57,7 @@ void gamedata_all(gamedata& gd) {
   gd.store(currentmap);
   gd.store(cwt);
   gd.store(allmaps);
+  gd.store(cell_arena);
   gd.store(shmup::on);
   gd.store(land_structure);
   gd.store(*current_display);
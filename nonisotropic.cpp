@@ -63,14 +63,38 @@ EX namespace sn {
   inline hyperpoint decompress(compressed_point p) { return point3(p[0], p[1], p[2]); }
   inline compressed_point compress(hyperpoint h) { return make_array<float>(h[0], h[1], h[2]); }
 
+  /** the header of a geodesic table file; the older files have no magic, version and offset,
+   *  and their data starts right after PRECX, PRECY, PRECZ */
+  struct table_header {
+    char magic[4];
+    int version;
+    int PRECX, PRECY, PRECZ;
+    /** where the data starts, from the beginning of the file */
+    int offset;
+    };
+
+  static const char table_magic[5] = "HRGT";
+  static const int table_version = 1;
+
+  /** a table of inverse geodesics. The file is memory-mapped where possible, so only the parts which are
+   *  actually used get paged in; otherwise (or when the table is being built) the data is in 'own' */
   struct tabled_inverses {
     int PRECX, PRECY, PRECZ;
-    vector<compressed_point> tab;
+    compressed_point *tab;
+    vector<compressed_point> own;
     string fname;
+    /** a higher-resolution variant of fname, used instead if hires_tables is on and the file exists */
+    string hires_fname;
     bool loaded;
+    void *mapped;
+    size_t mapped_size;
     
     void load();
+    bool load_from(const string& name);
+    void unload();
+    void allocate(int X, int Y, int Z);
     hyperpoint get(ld ix, ld iy, ld iz, bool lazy);
+    void get_array(const ld *ix, const ld *iy, const ld *iz, hyperpoint *res, int qty, bool lazy);
     
     compressed_point& get_int(int ix, int iy, int iz) { return tab[(iz*PRECY+iy)*PRECX+ix]; }
   
@@ -79,22 +103,91 @@ EX namespace sn {
     
     GLuint get_texture_id();
   
-    tabled_inverses(string s) : fname(s), texture_id(0), toload(true) {}  
+    tabled_inverses(string s, string hs) : tab(nullptr), fname(s), hires_fname(hs), loaded(false), mapped(nullptr), mapped_size(0), texture_id(0), toload(true) {}
     };
   #endif
+
+  /** prefer the higher-resolution geodesic tables generated by devmods/solv-table.cpp, if they are present */
+  EX bool hires_tables = false;
+
+  void tabled_inverses::allocate(int X, int Y, int Z) {
+    unload();
+    PRECX = X; PRECY = Y; PRECZ = Z;
+    own.resize(X * Y * Z);
+    tab = &own[0];
+    loaded = true;
+    }
+
+  void tabled_inverses::unload() {
+    #if CAP_MMAP
+    if(mapped) munmap(mapped, mapped_size);
+    #endif
+    mapped = nullptr;
+    mapped_size = 0;
+    own.clear();
+    tab = nullptr;
+    loaded = false;
+    toload = true;
+    }
+
+  bool tabled_inverses::load_from(const string& name) {
+    #if CAP_MMAP
+    int fd = open(name.c_str(), O_RDONLY);
+    if(fd < 0) return false;
+    struct stat st;
+    void *m = MAP_FAILED;
+    if(fstat(fd, &st) == 0 && st.st_size >= (off_t) sizeof(table_header))
+      m = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(m == MAP_FAILED) return false;
+    size_t size = st.st_size;
+    table_header h;
+    memcpy(&h, m, sizeof(h));
+    #else
+    FILE *f = fopen(name.c_str(), "rb");
+    if(!f) return false;
+    table_header h;
+    size_t size = fread(&h, 1, sizeof(h), f);
+    #endif
+    if(memcmp(h.magic, table_magic, 4)) {
+      int old[3];
+      memcpy(old, &h, sizeof(old));
+      h.PRECX = old[0]; h.PRECY = old[1]; h.PRECZ = old[2];
+      h.offset = sizeof(old);
+      }
+    else if(h.version != table_version) h.offset = 0;
+    size_t qty = size_t(h.PRECX) * h.PRECY * h.PRECZ;
+    #if CAP_MMAP
+    bool ok = h.PRECX > 1 && h.PRECY > 1 && h.PRECZ > 1 && h.offset > 0 && h.offset % 4 == 0 && h.offset + qty * sizeof(compressed_point) <= size;
+    if(!ok) { munmap(m, size); return false; }
+    mapped = m;
+    mapped_size = size;
+    tab = (compressed_point*) ((char*) m + h.offset);
+    #else
+    bool ok = size >= 3 * sizeof(int) && h.offset > 0 && h.PRECX > 1 && h.PRECY > 1 && h.PRECZ > 1 && fseek(f, h.offset, SEEK_SET) == 0;
+    if(ok) {
+      own.resize(qty);
+      ok = fread(&own[0], sizeof(compressed_point), qty, f) == qty;
+      }
+    fclose(f);
+    if(!ok) { own.clear(); return false; }
+    tab = &own[0];
+    #endif
+    PRECX = h.PRECX; PRECY = h.PRECY; PRECZ = h.PRECZ;
+    loaded = true;
+    return true;
+    }
   
   void tabled_inverses::load() {
     if(loaded) return;
-    FILE *f = fopen(fname.c_str(), "rb");
-    if(!f) f = fopen((rsrcdir + fname).c_str(), "rb");
-    if(!f) { addMessage(XLAT("geodesic table missing")); pmodel = mdPerspective; return; }
-    ignore(fread(&PRECX, 4, 1, f));
-    ignore(fread(&PRECY, 4, 1, f));
-    ignore(fread(&PRECZ, 4, 1, f));
-    tab.resize(PRECX * PRECY * PRECZ);
-    ignore(fread(&tab[0], sizeof(compressed_point) * PRECX * PRECY * PRECZ, 1, f));
-    fclose(f);
-    loaded = true;    
+    if(hires_tables && (load_from(hires_fname) || load_from(rsrcdir + hires_fname))) return;
+    if(load_from(fname) || load_from(rsrcdir + fname)) return;
+    addMessage(XLAT("geodesic table missing")); pmodel = mdPerspective;
+    }
+
+  /** forget the loaded tables, so that they are loaded again (e.g. after hires_tables is changed) */
+  EX void reload_tables() {
+    for(auto t: {&solt, &niht, &sont}) t->unload();
     }
   
   hyperpoint tabled_inverses::get(ld ix, ld iy, ld iz, bool lazy) {
@@ -132,6 +225,50 @@ EX namespace sn {
     return res;
     }
   
+  /** same as get for qty points; the cell indices and weights are computed for all the points first, so that this part can be vectorized */
+  void tabled_inverses::get_array(const ld *ix, const ld *iy, const ld *iz, hyperpoint *res, int qty, bool lazy) {
+    if(lazy) {
+      for(int i=0; i<qty; i++) res[i] = get(ix[i], iy[i], iz[i], true);
+      return;
+      }
+    
+    const int lanes = 64;
+    ld fx[lanes], fy[lanes], fz[lanes];
+    int ax[lanes], ay[lanes], az[lanes];
+    
+    for(int from=0; from<qty; from+=lanes) {
+      int n = min(lanes, qty-from);
+      
+      for(int i=0; i<n; i++) {
+        ld x = ix[from+i] * (PRECX-1);
+        ld y = iy[from+i] * (PRECY-1);
+        ld z = iz[from+i] * (PRECZ-1);
+        if(x >= PRECX-1 || isnan(x)) x = PRECX-2;
+        if(y >= PRECX-1 || isnan(y)) y = PRECX-2;
+        if(z >= PRECZ-1 || isnan(z)) z = PRECZ-2;
+        fx[i] = x; fy[i] = y; fz[i] = z;
+        ax[i] = x; ay[i] = y; az[i] = z;
+        }
+      
+      for(int i=0; i<n; i++) {
+        int x = ax[i], y = ay[i], z = az[i];
+        ld wx0 = x+1-fx[i], wx1 = fx[i]-x;
+        ld wy0 = y+1-fy[i], wy1 = fy[i]-y;
+        ld wz0 = z+1-fz[i], wz1 = fz[i]-z;
+        auto *p000 = &get_int(x, y, z), *p001 = &get_int(x, y, z+1);
+        auto *p010 = &get_int(x, y+1, z), *p011 = &get_int(x, y+1, z+1);
+        auto *p100 = &get_int(x+1, y, z), *p101 = &get_int(x+1, y, z+1);
+        auto *p110 = &get_int(x+1, y+1, z), *p111 = &get_int(x+1, y+1, z+1);
+        hyperpoint& r = res[from+i];
+        for(int t=0; t<3; t++)
+          r[t] =
+            (((*p000)[t] * wz0 + (*p001)[t] * wz1) * wy0 + ((*p010)[t] * wz0 + (*p011)[t] * wz1) * wy1) * wx0 +
+            (((*p100)[t] * wz0 + (*p101)[t] * wz1) * wy0 + ((*p110)[t] * wz0 + (*p111)[t] * wz1) * wy1) * wx1;
+        r[3] = 0;
+        }
+      }
+    }
+  
   GLuint tabled_inverses::get_texture_id() {
     #if CAP_GL
     if(!toload) return texture_id;
@@ -153,20 +290,22 @@ EX namespace sn {
     glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
     
-    auto xbuffer = new glvertex[PRECZ*PRECY*PRECX];
-    
-    for(int z=0; z<PRECZ*PRECY*PRECX; z++) {
-      auto& t = tab[z];
-      xbuffer[z] = glhr::makevertex(t[0], t[1], t[2]);
-      }
+    /* upload one z-slice at a time, so that a large table does not need a full copy in memory */
+    vector<glvertex> xbuffer(PRECY*PRECX);
     
     #if !ISWEB
-    glTexImage3D(GL_TEXTURE_3D, 0, 34836 /*GL_RGBA32F*/, PRECX, PRECX, PRECZ, 0, GL_RGBA, GL_FLOAT, xbuffer);
+    glTexImage3D(GL_TEXTURE_3D, 0, 34836 /*GL_RGBA32F*/, PRECX, PRECY, PRECZ, 0, GL_RGBA, GL_FLOAT, nullptr);
+    for(int z=0; z<PRECZ; z++) {
+      for(int i=0; i<PRECY*PRECX; i++) {
+        auto& t = tab[z*PRECY*PRECX+i];
+        xbuffer[i] = glhr::makevertex(t[0], t[1], t[2]);
+        }
+      glTexSubImage3D(GL_TEXTURE_3D, 0, 0, 0, z, PRECX, PRECY, 1, GL_RGBA, GL_FLOAT, &xbuffer[0]);
+      }
     #else
     // glTexStorage3D(GL_TEXTURE_3D, 1, 34836 /*GL_RGBA32F*/, PRECX, PRECX, PRECZ);
     // glTexSubImage3D(GL_TEXTURE_3D, 0, 0, 0, 0, PRECX, PRECY, PRECZ, GL_RGBA, GL_FLOAT, xbuffer);
     #endif
-    delete[] xbuffer;
     #endif
     return texture_id;
     }
@@ -521,7 +660,6 @@ EX namespace sn {
   
   EX hyperpoint get_inverse_exp_symsol(hyperpoint h, flagtype flags) {
     auto& s = get_tabled();
-    s.load();
     
     ld ix = h[0] >= 0. ? sn::x_to_ix(h[0]) : sn::x_to_ix(-h[0]);
     ld iy = h[1] >= 0. ? sn::x_to_ix(h[1]) : sn::x_to_ix(-h[1]);
@@ -539,9 +677,43 @@ EX namespace sn {
     return table_to_azeq(res);
     }
 
+  /** get_inverse_exp_symsol or get_inverse_exp_nsym for qty points at once (including the small distance case from inverse_exp) */
+  EX void get_inverse_exp_array(const shiftpoint *h, hyperpoint *res, int qty, flagtype flags) {
+    auto& s = get_tabled();
+    
+    const int lanes = 64;
+    ld ix[lanes], iy[lanes], iz[lanes];
+    bool symsol = !nih;
+    
+    for(int from=0; from<qty; from+=lanes) {
+      int n = min(lanes, qty-from);
+      const shiftpoint *hb = h + from;
+      hyperpoint *rb = res + from;
+      
+      for(int i=0; i<n; i++) {
+        const hyperpoint& p = hb[i].h;
+        ix[i] = x_to_ix(abs(p[0]));
+        iy[i] = x_to_ix(abs(p[1]));
+        iz[i] = z_to_iz(p[2]);
+        if(symsol && p[2] < 0.) { iz[i] = -iz[i]; swap(ix[i], iy[i]); }
+        }
+      
+      s.get_array(ix, iy, iz, rb, n, flags & pfNO_INTERPOLATION);
+      
+      for(int i=0; i<n; i++) {
+        const hyperpoint& p = hb[i].h;
+        hyperpoint& r = rb[i];
+        if(sqhypot_d(3, p) < 2e-9) { r = p - C0; continue; }
+        if(symsol && p[2] < 0.) { swap(r[0], r[1]); r[2] = -r[2]; }
+        if(p[0] < 0.) r[0] = -r[0];
+        if(p[1] < 0.) r[1] = -r[1];
+        if(!(flags & pfNO_DISTANCE)) r = table_to_azeq(r);
+        }
+      }
+    }
+
   EX hyperpoint get_inverse_exp_nsym(hyperpoint h, flagtype flags) {
     auto& s = get_tabled();
-    s.load();
     
     ld ix = h[0] >= 0. ? sn::x_to_ix(h[0]) : sn::x_to_ix(-h[0]);
     ld iy = h[1] >= 0. ? sn::x_to_ix(h[1]) : sn::x_to_ix(-h[1]);
@@ -670,17 +842,21 @@ EX namespace sn {
     return abs(h[0]) < solrange_xy && abs(h[1]) < solrange_xy && abs(h[2]) < solrange_z;
     }
 
-  EX tabled_inverses solt = sn::tabled_inverses("solv-geodesics.dat");
-  EX tabled_inverses niht = sn::tabled_inverses("shyp-geodesics.dat");
-  EX tabled_inverses sont = sn::tabled_inverses("ssol-geodesics.dat");
+  EX tabled_inverses solt = sn::tabled_inverses("solv-geodesics.dat", "solv-geodesics-hires.dat");
+  EX tabled_inverses niht = sn::tabled_inverses("shyp-geodesics.dat", "shyp-geodesics-hires.dat");
+  EX tabled_inverses sont = sn::tabled_inverses("ssol-geodesics.dat", "ssol-geodesics-hires.dat");
   
+  /** the table for the current geometry; it is loaded on the first call */
   EX tabled_inverses& get_tabled() {
+    tabled_inverses *t;
     switch(geom()) {
-      case gSol: return solt;
-      case gNIH: return niht;
-      case gSolN: return sont;
+      case gSol: t = &solt; break;
+      case gNIH: t = &niht; break;
+      case gSolN: t = &sont; break;
       default: throw hr_exception("not solnih");
       }
+    t->load();
+    return *t;
     }
 
   EX int approx_distance(heptagon *h1, heptagon *h2) {
@@ -817,6 +993,56 @@ EX namespace nilv {
       }
     }
   
+  /** get_inverse_exp for qty points at once; the binary searches for consecutive points are interleaved */
+  EX void get_inverse_exp_array(const shiftpoint *h, hyperpoint *res, int qty, flagtype prec IS(pNORMAL)) {
+    const int lanes = 64;
+    ld wmin[lanes], wmax[lanes], b[lanes], s[lanes], hz[lanes], alpha_total[lanes];
+    int lane_of[lanes];
+    
+    int max_iter = (prec & pfLOW_BS_ITER) ? 5 : 20;
+    
+    for(int from=0; from<qty; from+=lanes) {
+      int n = min(lanes, qty-from);
+      int q = 0;
+
+      /* the special cases are solved at once, the others get a lane */
+      for(int i=0; i<n; i++) {
+        const hyperpoint& p = h[from+i].h;
+        ld side = p[2] - p[0] * p[1] / 2;
+        if(hypot_d(2, p) < 1e-6) { res[from+i] = point3(p[0], p[1], p[2]); continue; }
+        else if(side > 1e-6) wmin[q] = 0, wmax[q] = 2 * M_PI;
+        else if(side < -1e-6) wmin[q] = - 2 * M_PI, wmax[q] = 0;
+        else { res[from+i] = point3(p[0], p[1], 0); continue; }
+        
+        ld at = p[0] ? atan(p[1] / p[0]) : M_PI/2;
+        alpha_total[q] = at;
+        if(abs(p[0]) > abs(p[1]))
+          b[q] = p[0] / 2 / cos(at);
+        else
+          b[q] = p[1] / 2 / sin(at);
+        s[q] = sin(2 * at);
+        hz[q] = p[2];
+        lane_of[q] = from+i;
+        q++;
+        }
+      
+      for(int it=0; it<max_iter; it++) 
+      for(int j=0; j<q; j++) {
+        ld w = (wmin[j] + wmax[j]) / 2;
+        ld z = b[j] * b[j] * (s[j] + (sin(w) - w)/(cos(w) - 1)) + w;
+        if(hz[j] > z) wmin[j] = w;
+        else wmax[j] = w;
+        }
+      
+      for(int j=0; j<q; j++) {
+        ld w = (wmin[j] + wmax[j]) / 2;
+        ld alpha = alpha_total[j] - w/2;
+        ld c = b[j] / sin(w/2);
+        res[lane_of[j]] = point3(c * w * cos(alpha), c * w * sin(alpha), w);
+        }
+      }
+    }
+  
   EX string nilshader = 
     "vec4 inverse_exp(vec4 h) {"
       "float wmin, wmax;"
@@ -2845,6 +3071,11 @@ EX namespace nisot {
       shift(); sn::niht.fname = args();
       return 0;
       }
+    else if(argis("-sol-hires")) {
+      shift(); sn::hires_tables = argi();
+      sn::reload_tables();
+      return 0;
+      }
     #endif
     else if(argis("-solgeo")) {
       geodesic_movement = true;
@@ -1019,6 +1019,16 @@ void geometry_information::prepare_shapes() {
 
   if(fake::in()) { FPIU( cgi.require_shapes() ); }
 
+  #if CAP_SHAPECACHE
+  string cache_key;
+  if(shapecache::dir != "") {
+    /* the shapes which are not generated in this geometry are left as they are, so make them predictable */
+    for_each_shape([] (hpcshape& sh) { sh.clear(); });
+    cache_key = shapecache::key();
+    if(shapecache::load(*this, cache_key)) return;
+    }
+  #endif
+
   symmetriesAt.clear();
   allshapes.clear();
   DEBBI(DF_POLY, ("buildpolys"));
@@ -1486,6 +1496,10 @@ void geometry_information::prepare_shapes() {
   prehpc = isize(hpc);
 
   initPolyForGL();
+
+  #if CAP_SHAPECACHE
+  if(cache_key != "") shapecache::save(*this, cache_key);
+  #endif
   }
 
 EX vector<long double> polydata = {
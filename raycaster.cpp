@@ -26,9 +26,8 @@ EX int want_use = 1;
 /** generate the map for raycasting just once */
 EX bool fixed_map = false;
 
-EX ld exp_start = 1;
-EX ld exp_decay_exp = 4;
-EX ld exp_decay_poly = 10;
+/** update the map for raycasting by regenerating only the cells which have changed */
+EX bool incremental = true;
 
 #ifdef GLES_ONLY
 const int gms_limit = 16; /* enough for Bringris -- need to do better */
@@ -38,14 +37,24 @@ const int gms_limit = 110;
 
 EX int gms_array_size = 16;
 
+EX ld reflect_val = 0;
+
+#endif
+
+/* the parameters below are shared with the CPU raycaster (raycpu.cpp) */
+
+#if CAP_RAY || CAP_RAYCPU
+
+EX ld exp_start = 1;
+EX ld exp_decay_exp = 4;
+EX ld exp_decay_poly = 10;
+
 EX ld maxstep_sol = .05;
 EX ld maxstep_nil = .1;
 EX ld maxstep_pro = .5;
 EX ld maxstep_intra = .05;
 EX ld minstep = .001;
 
-EX ld reflect_val = 0;
-
 static const int NO_LIMIT = 999999;
 
 EX ld hard_limit = NO_LIMIT;
@@ -87,7 +96,7 @@ EX bool horos() {
   return (hyperbolic || in_h2xe()) && bt::in();
   }
 
-ld& maxstep_current() {
+EX ld& maxstep_current() {
   if(intra::in) return maxstep_intra;
   if(sn::in() || stretch::in()) return maxstep_sol;
   #if CAP_VR
@@ -97,6 +106,12 @@ ld& maxstep_current() {
   return maxstep_nil;
   }
 
+EX color_t color_out_of_range = 0x0F0800FF;
+
+#endif
+
+#if CAP_RAY
+
 #define IN_ODS 0
 
 eGeometry last_geometry;
@@ -2060,12 +2075,22 @@ void bind_array(vector<array<float, 4>>& v, GLint t, GLuint& tx, int id, int len
   GLERR("bind_array");
   }
 
+void rebind_array(GLuint tx, int id) {
+  glActiveTexture(GL_TEXTURE0 + id);
+  glBindTexture(GL_TEXTURE_2D, tx);
+  }
+
+/** replace w texels of the row y, starting at x, by the corresponding part of v */
+void patch_array(vector<array<float, 4>>& v, GLuint tx, int id, int length, int x, int y, int w) {
+  rebind_array(tx, id);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, w, 1, GL_RGBA, GL_FLOAT, &v[y * length + x]);
+  GLERR("patch_array");
+  }
+
 void uniform2(GLint id, array<float, 2> fl) {
   glUniform2f(id, fl[0], fl[1]);
   }
 
-color_t color_out_of_range = 0x0F0800FF;
-
 EX transmatrix get_ms(cell *c, int a, bool mirror) {
   int z = a ? 1 : -1;
   
@@ -2113,8 +2138,17 @@ struct raycast_map {
 
   int saved_frameid;
   
+  /** cells by their slot in the data textures; nullptr for free slots */
   vector<cell*> lst;
-  map<cell*, int> ids;
+  ptr_index<cell> ids;
+  /** slots left free by cells which are no longer listed */
+  vector<int> free_ids;
+  /** for every slot, a hash of everything its texels depend on (see cell_key) */
+  vector<unsigned> keys;
+  /** the cell the listing was generated from */
+  cell *listed_center = nullptr;
+  /** the raycaster our data has been assigned to */
+  raycaster *assigned_to = nullptr;
 
   vector<transmatrix> ms;
 
@@ -2193,7 +2227,7 @@ struct raycast_map {
       }
     }
   
-  void generate_cell_listing(cell *cs) {
+  vector<cell*> list_cells(cell *cs) {
     manual_celllister cl;
     cl.add(cs);
     bool optimize = !isWall3(cs);
@@ -2227,9 +2261,59 @@ struct raycast_map {
         }
       }
     finish:
-    lst = cl.lst;
+    return cl.lst;
+    }
+
+  void generate_cell_listing(cell *cs) {
+    lst = list_cells(cs);
+    listed_center = cs;
+    free_ids.clear();
+    ids.clear();
+    for(int i=0; i<isize(lst); i++) ids.insert(lst[i], i);
+    }
+
+  /** list the cells around cs again; the cells which remain listed keep their slots */
+  bool relist(cell *cs) {
+    auto listing = list_cells(cs);
+    ptr_index<cell> listed;
+    for(cell *c: listing) listed.insert(c, 0);
     ids.clear();
-    for(int i=0; i<isize(lst); i++) ids[lst[i]] = i;
+    for(int id=0; id<isize(lst); id++) if(lst[id]) {
+      if(listed.find(lst[id]) < 0) lst[id] = nullptr, free_ids.push_back(id);
+      else ids.insert(lst[id], id);
+      }
+    for(cell *c: listing) if(ids.find(c) < 0) {
+      int id;
+      if(free_ids.empty()) id = isize(lst), lst.push_back(nullptr), keys.push_back(0);
+      else id = free_ids.back(), free_ids.pop_back();
+      lst[id] = c;
+      keys[id] = 0;
+      ids.insert(c, id);
+      }
+    listed_center = cs;
+    return isize(lst) <= per_row * rows;
+    }
+
+  /** what the raycaster sees of c itself */
+  unsigned cell_sig(cell *c) {
+    unsigned h = c->wall;
+    h = h * 31 + c->land;
+    h = h * 31 + c->wparam;
+    h = h * 31 + c->landparam;
+    h = h * 31 + c->item;
+    if(volumetric::on) {
+      auto p = at_or_null(volumetric::vmap, c);
+      if(p) h = h * 31 + *p;
+      }
+    return h;
+    }
+
+  /** the texels of c depend on c and on the neighbors of c, including their slots; never 0 */
+  unsigned cell_key(cell *c) {
+    unsigned h = cell_sig(c);
+    forCellIdEx(c1, i, c)
+      h = (h * 1000003 + i) * 1000003 + (ids.find(c1) + 1) * 31 + cell_sig(c1);
+    return h | 1;
     }
 
   array<float, 2> enc(int i, int a) { 
@@ -2263,12 +2347,12 @@ struct raycast_map {
         if(p) c1 = p->tcw.at;
         }
       int u = (id/per_row*length) + (id%per_row * deg) + i;
-      if(!ids.count(c1)) {
+      if(ids.find(c1) < 0) {
         wallcolor[u] = glhr::acolor(color_out_of_range | 0xFF);
         texturemap[u] = glhr::makevertex(0.1,0,0);
         continue;
         }
-      auto code = enc(ids[c1], 0);
+      auto code = enc(ids.find(c1), 0);
       connections[u][0] = code[0];
       connections[u][1] = code[1];
       portal_connections[u][0] = 0;
@@ -2358,10 +2442,9 @@ struct raycast_map {
     }
   
   void generate_connections() {
-    int id = 0;
     intra::resetter ir;
-    for(cell* c: lst) if(!reset_rmap)
-      generate_connections(c, id++);
+    for(int id=0; id<isize(lst); id++) if(lst[id] && !reset_rmap)
+      generate_connections(lst[id], id);
     }
   
   bool gms_exceeded() {
@@ -2369,11 +2452,7 @@ struct raycast_map {
     return isize(ms) > gms_array_size;
     }
 
-  void assign_uniforms(raycaster* o) {
-    if(!o) return;
-    glUniform1i(o->uLength, length);
-    GLERR("uniform mediump length");
-    
+  void assign_ms(raycaster* o) {
     if(m_via_texture) {
       int mlength = next_p2(isize(ms));
       vector<array<float, 4>> m_map;
@@ -2392,6 +2471,15 @@ struct raycast_map {
       for(auto& m: ms) gms.push_back(glhr::tmtogl_transpose3(m));
       glUniformMatrix4fv(o->uM, isize(gms), 0, gms[0].as_array());
       }
+    }
+
+  void assign_uniforms(raycaster* o) {
+    if(!o) return;
+    assigned_to = o;
+    glUniform1i(o->uLength, length);
+    GLERR("uniform mediump length");
+    
+    assign_ms(o);
     
     bind_array(wallcolor, o->tWallcolor, txWallcolor, 4, length);
     bind_array(connections, o->tConnections, txConnections, 3, length);
@@ -2405,17 +2493,73 @@ struct raycast_map {
       }
     }
   
+  /** other shaders may have used our texture units in the meantime */
+  void rebind(raycaster* o) {
+    rebind_array(txWallcolor, 4);
+    rebind_array(txConnections, 3);
+    rebind_array(txTextureMap, 5);
+    if(volumetric::on) rebind_array(txVolumetric, 6);
+    if(o->tPortalConnections != -1) rebind_array(txPortalConnections, 1);
+    if(m_via_texture) rebind_array(txM, 7);
+    glActiveTexture(GL_TEXTURE0 + 0);
+    }
+
+  /** upload the texels of the given slots (in increasing order), one span per run of consecutive slots in a row */
+  void patch(const vector<int>& changed, raycaster* o) {
+    for(int i=0; i<isize(changed);) {
+      int j = i+1;
+      while(j < isize(changed) && changed[j] == changed[j-1]+1 && changed[j] / per_row == changed[i] / per_row) j++;
+      int x = changed[i] % per_row * deg, y = changed[i] / per_row, w = (j-i) * deg;
+      patch_array(wallcolor, txWallcolor, 4, length, x, y, w);
+      patch_array(connections, txConnections, 3, length, x, y, w);
+      patch_array(texturemap, txTextureMap, 5, length, x, y, w);
+      if(volumetric::on) patch_array(volumetric, txVolumetric, 6, length, x, y, w);
+      if(o->tPortalConnections != -1)
+        patch_array(portal_connections, txPortalConnections, 1, length, x, y, w);
+      i = j;
+      }
+    glActiveTexture(GL_TEXTURE0 + 0);
+    }
+
   void create_all(cell *cs) {
     saved_frameid = frameid;
     generate_initial_ms(cs);
     generate_cell_listing(cs);
     apply_shape();
     generate_connections();
+    keys.resize(isize(lst));
+    for(int id=0; id<isize(lst); id++) keys[id] = cell_key(lst[id]);
+    }
+
+  /** regenerate only the slots whose keys have changed; false if everything needs to be created again */
+  bool update(cell *cs, raycaster* o) {
+    saved_frameid = frameid;
+    if(o != assigned_to) return false;
+    if(cs != listed_center && !relist(cs)) return false;
+    int ms_size = isize(ms);
+    vector<int> changed;
+    for(int id=0; id<isize(lst); id++) if(lst[id]) {
+      unsigned k = cell_key(lst[id]);
+      if(k == keys[id]) continue;
+      keys[id] = k;
+      generate_connections(lst[id], id);
+      if(reset_rmap) return false;
+      changed.push_back(id);
+      }
+    if(gms_exceeded()) return false;
+    if(isize(ms) != ms_size) assign_ms(o);
+    rebind(o);
+    patch(changed, o);
+    return true;
+    }
+
+  bool can_update() {
+    return !fixed_map && incremental && !intra::in && frameid != saved_frameid;
     }
   
   bool need_to_create(cell *cs) {
-    if(!fixed_map && frameid != saved_frameid) return true;
-    return !ids.count(cs);
+    if(!fixed_map && !(incremental && !intra::in) && frameid != saved_frameid) return true;
+    return ids.find(cs) < 0;
     }
   };
 
@@ -2427,12 +2571,18 @@ EX cell* rmap_get_by_id(int id) {
   }
 
 EX int rmap_get_id_of(cell *c) {
-  return rmap->ids[c];
+  return rmap->ids.find(c);
   }
 
+/** which walls have been loaded by cast() */
+raycaster *walls_loaded_for;
+geometry_information *walls_loaded_cgi;
+int walls_loaded_count;
+
 EX void reset_raycaster() { 
   our_raycaster = nullptr; 
   reset_rmap = true;
+  walls_loaded_for = nullptr;
   rots::saved_matrices_ray = {};
   }
 
@@ -2574,44 +2724,54 @@ EX void cast() {
     glUniform1i(o->uSides, cs->type + (WDIM == 2 ? 2 : 0));
     }
 
-  vector<glvertex> wallx, wally;
-  vector<GLint> wallstart;
+  bool walls_loaded = !intra::in && walls_loaded_for == &*o && walls_loaded_cgi == &cgi && walls_loaded_count == isize(cgi.raywall);
+  if(walls_loaded) {
+    if(wall_via_texture) rebind_array(txWall, 8);
+    }
+  else {
+    walls_loaded_for = &*o;
+    walls_loaded_cgi = &cgi;
+    walls_loaded_count = isize(cgi.raywall);
 
-  if(intra::in) {
-    intra::resetter ir;
-    for(int i=0; i<isize(intra::data); i++) {
-      intra::switch_to(i);
-      load_walls(wallx, wally, wallstart);
+    vector<glvertex> wallx, wally;
+    vector<GLint> wallstart;
+
+    if(intra::in) {
+      intra::resetter ir;
+      for(int i=0; i<isize(intra::data); i++) {
+        intra::switch_to(i);
+        load_walls(wallx, wally, wallstart);
+        }
       }
-    }
-  else
-    load_walls(wallx, wally, wallstart);
-
-  if(wall_via_texture) {
-    int wlength = next_p2(isize(wallx));
-    vector<array<float, 4>> w_map;
-    w_map.resize(4 * wlength);
-    ld minval = 9, maxval = -9;
-    for(int i=0; i<isize(wallx); i++) {
-      for(int a=0; a<4; a++) {
-        w_map[i][a] = wallx[i][a]/ray_scale + .5;
-        w_map[i+wlength][a] = wally[i][a]/ray_scale + .5;
-        minval = min<ld>(minval, w_map[i][a]);
-        minval = min<ld>(minval, w_map[i+wlength][a]);
-        maxval = max<ld>(maxval, w_map[i][a]);
-        maxval = max<ld>(maxval, w_map[i+wlength][a]);
+    else
+      load_walls(wallx, wally, wallstart);
+
+    if(wall_via_texture) {
+      int wlength = next_p2(isize(wallx));
+      vector<array<float, 4>> w_map;
+      w_map.resize(4 * wlength);
+      ld minval = 9, maxval = -9;
+      for(int i=0; i<isize(wallx); i++) {
+        for(int a=0; a<4; a++) {
+          w_map[i][a] = wallx[i][a]/ray_scale + .5;
+          w_map[i+wlength][a] = wally[i][a]/ray_scale + .5;
+          minval = min<ld>(minval, w_map[i][a]);
+          minval = min<ld>(minval, w_map[i+wlength][a]);
+          maxval = max<ld>(maxval, w_map[i][a]);
+          maxval = max<ld>(maxval, w_map[i+wlength][a]);
+          }
         }
+      // println(hlog, "wallrange = ", tie(minval, maxval), " wallx = ", isize(wallx), " wallstart = ", isize(cgi.wallstart));
+      for(int i=0; i<isize(wallstart); i++)
+        w_map[i+2*wlength][0] = (wallstart[i]+.5) / wlength;
+      bind_array(w_map, o->tWall, txWall, 8, wlength);
+      glUniform1f(o->uInvLengthWall, 1. / wlength);
+      }
+    else {
+      glUniform1iv(o->uWallstart, isize(wallstart), &wallstart[0]);  
+      glUniform4fv(o->uWallX, isize(wallx), &wallx[0][0]);
+      glUniform4fv(o->uWallY, isize(wally), &wally[0][0]);
       }
-    // println(hlog, "wallrange = ", tie(minval, maxval), " wallx = ", isize(wallx), " wallstart = ", isize(cgi.wallstart));
-    for(int i=0; i<isize(wallstart); i++)
-      w_map[i+2*wlength][0] = (wallstart[i]+.5) / wlength;
-    bind_array(w_map, o->tWall, txWall, 8, wlength);
-    glUniform1f(o->uInvLengthWall, 1. / wlength);
-    }
-  else {
-    glUniform1iv(o->uWallstart, isize(wallstart), &wallstart[0]);  
-    glUniform4fv(o->uWallX, isize(wallx), &wallx[0][0]);
-    glUniform4fv(o->uWallY, isize(wally), &wally[0][0]);
     }
 
   if(o->uLevelLines != -1)
@@ -2652,7 +2812,10 @@ EX void cast() {
 
   if(!rmap) rmap = (unique_ptr<raycast_map>) new raycast_map;
   
-  if(rmap->need_to_create(cs)) {
+  bool create = rmap->need_to_create(cs);
+  if(!create && rmap->can_update()) create = !rmap->update(cs, &*o);
+  else if(!create) rmap->rebind(&*o);
+  if(create) {
     rmap->create_all(cs);  
     if(reset_rmap) {
       reset_raycaster();
@@ -2688,7 +2851,7 @@ EX void cast() {
   GLERR("uniform mediump start");
   
   if(!o) { cast(); return; }
-  uniform2(o->uStartid, rmap->enc(rmap->ids[cs], 0));
+  uniform2(o->uStartid, rmap->enc(rmap->ids.find(cs), 0));
   }
 
   #if CAP_VERTEXBUFFER
@@ -2972,7 +3135,8 @@ int readArgs() {
   }
 
 auto hook = addHook(hooks_args, 100, readArgs)
- + addHook(hooks_clearmemory, 40, [] { rmap = {}; });
+ + addHook(hooks_clearmemory, 40, [] { rmap = {}; })
+ + addHook(hooks_removecells, 40, [] { rmap = {}; });
 #endif
 
 #if CAP_CONFIG
@@ -2991,6 +3155,7 @@ void addconfig() {
   param_i(max_cells, "ray_max_cells");
   addsaver(rays_generate, "ray_generate");
   param_b(fixed_map, "ray_fixed_map");
+  param_b(incremental, "ray_incremental");
   }
 auto hookc = addHook(hooks_configfile, 100, addconfig);
 #endif
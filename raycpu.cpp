@@ -0,0 +1,450 @@
+// Hyperbolic Rogue -- CPU raycaster
+// Copyright (C) 2011-2019 Zeno Rogue, see 'hyper.cpp' for details
+
+/** \file raycpu.cpp
+ *  \brief A CPU implementation of the raycaster, for headless rendering and for testing the shaders.
+ *
+ *  The rays are marched in the same way as in the shader generated by raycaster.cpp, but in double
+ *  precision, and without texture lookups, reflections and volumetric fog. The cells are listed and
+ *  colored first, on the main thread; then the pixels are computed in parallel.
+ */
+
+#include "hyper.h"
+
+namespace hr {
+
+EX namespace ray {
+
+#if CAP_RAYCPU
+EX namespace cpu {
+
+/** the number of threads used; -1 = one per hardware thread */
+EX int threads = -1;
+
+/** a face of a listed cell, with everything a ray needs to know when it reaches it */
+struct face {
+  /** ray_iadj: the wall is where a point is equally far from C0 and from its image by ms */
+  transmatrix ms;
+  /** maps the coordinates of this cell to the coordinates of the neighbor */
+  transmatrix conn;
+  /** the index of the neighbor, or -1 if it is not listed */
+  int next;
+  /** the index of this face in cgi.wallstart */
+  int wall;
+  /** the color of the wall, as RGBA in [0,1] */
+  array<ld, 4> col;
+  /** the width of the darkened band along the edges of the face (texturemap.x in the shader) */
+  ld edge;
+  };
+
+struct cell_faces { int first, sides; };
+
+struct map_data {
+  vector<cell*> lst;
+  vector<cell_faces> cells;
+  vector<face> faces;
+  };
+
+EX bool supported() {
+  if(GDIM != 3 || WDIM != 3 || intra::in || is_eyes() || stretch::in()) return false;
+  if(nil) return S7 != 8;
+  #if CAP_SOLV
+  if(sol) return !nih && !asonov::in();
+  #endif
+  if(nonisotropic || prod || bt::in() || kite::in()) return false;
+  return hyperbolic || sphere || euclid;
+  }
+
+/** list the cells in the same way as raycast_map::list_cells */
+void list_cells(map_data& md, cell *cs) {
+  manual_celllister cl;
+  cl.add(cs);
+  bool optimize = !isWall3(cs);
+  for(int i=0; i<isize(cl.lst); i++) {
+    cell *c = cl.lst[i];
+    if(racing::on && i > 0 && c->wall == waBarrier) continue;
+    if(optimize && isWall3(c)) continue;
+    forCellCM(c2, c) {
+      if(rays_generate) setdist(c2, 7, c);
+      cl.add(c2);
+      if(isize(cl.lst) >= max_cells) goto finish;
+      }
+    }
+  finish:
+  md.lst = cl.lst;
+  }
+
+array<ld, 4> shaded(color_t col, int darkval) {
+  ld p = 1 - darkval / 16.;
+  return {{ part(col, 3) / 255. * p, part(col, 2) / 255. * p, part(col, 1) / 255. * p, part(col, 0) / 255. }};
+  }
+
+/** compute the faces in the same way as raycast_map::generate_connections */
+void prepare_faces(map_data& md) {
+  ptr_index<cell> ids;
+  for(int i=0; i<isize(md.lst); i++) ids.insert(md.lst[i], i);
+  for(cell *c: md.lst) {
+    md.cells.push_back(cell_faces{isize(md.faces), c->type});
+    int wo = currentmap->wall_offset(c);
+    for(int i=0; i<c->type; i++) {
+      face f;
+      cell *c1 = c->move(i);
+      f.ms = currentmap->ray_iadj(c, i);
+      f.next = c1 ? ids.find(c1) : -1;
+      f.conn = f.next >= 0 ? currentmap->iadj(c, i) : Id;
+      f.wall = wo + i;
+      f.edge = .1;
+      if(f.next < 0)
+        f.col = shaded(color_out_of_range | 0xFF, 0);
+      else if(isWall3(c1)) {
+        celldrawer dd;
+        dd.c = c1;
+        dd.setcolors();
+        shiftmatrix Vf;
+        dd.set_land_floor(Vf);
+        f.col = shaded(darkena(dd.wcol, 0, 0xFF), get_darkval(c1, c->c.spin(i)));
+        }
+      else {
+        color_t col = transcolor(c, c1, winf[c->wall].color) | transcolor(c1, c, winf[c1->wall].color);
+        if(col == 0) f.col = {{0, 0, 0, 0}};
+        else f.col = shaded(col, get_darkval(c1, c->c.spin(i)));
+        f.edge = .001;
+        }
+      md.faces.push_back(f);
+      }
+    }
+  }
+
+/** everything the threads need; they only read it */
+struct context {
+  map_data md;
+  transmatrix start;
+  bool stepbased;
+  int max_iter;
+  ld maxstep, minstep, sightrange, exp_start, exp_decay, hard_limit, binary_width;
+  array<ld, 3> fog;
+  };
+
+/** where the wall given by ms is hit by the geodesic (position, tangent), as in raygen::compute_which_and_dist */
+bool wall_distance(const transmatrix& m, const hyperpoint& position, const hyperpoint& tangent, ld& d) {
+  hyperpoint mp = m * position, mt = m * tangent;
+  if(hyperbolic) {
+    ld v = (position[3] - mp[3]) / (mt[3] - tangent[3]);
+    if(!(v <= 1 && v >= -1)) return false;
+    d = atanh(v);
+    hyperpoint nt = position * sinh(d) + tangent * cosh(d);
+    return nt[3] >= (m * nt)[3];
+    }
+  if(sphere) {
+    ld v = (position[3] - mp[3]) / (mt[3] - tangent[3]);
+    d = atan(v);
+    hyperpoint nt = tangent * cos(d) - position * sin(d);
+    return nt[3] <= (m * nt)[3];
+    }
+  ld deno = dot_d(4, position, tangent) - dot_d(4, mp, mt);
+  if(deno < 1e-6 && deno > -1e-6) return false;
+  d = (dot_d(4, mp, mp) - dot_d(4, position, position)) / 2 / deno;
+  if(d < 0) return false;
+  hyperpoint np = position + tangent * d;
+  return dot_d(4, np, tangent) >= dot_d(4, m * np, m * tangent);
+  }
+
+void move_along(hyperpoint& position, hyperpoint& tangent, ld dist) {
+  if(hyperbolic) {
+    ld ch = cosh(dist), sh = sinh(dist);
+    hyperpoint v = position * ch + tangent * sh;
+    tangent = tangent * ch + position * sh;
+    position = v;
+    position /= sqrt(position[3] * position[3] - sqhypot_d(3, position));
+    tangent -= (position[3] * tangent[3] - dot_d(3, position, tangent)) * position;
+    tangent /= sqrt(sqhypot_d(3, tangent) - tangent[3] * tangent[3]);
+    }
+  else if(sphere) {
+    ld ch = cos(dist), sh = sin(dist);
+    hyperpoint v = position * ch + tangent * sh;
+    tangent = tangent * ch - position * sh;
+    position = v;
+    }
+  else position = position + tangent * dist;
+  }
+
+/** the face of a Nil or Sol cell through which h has left it, or -1; see raygen::move_forward */
+int exit_face(const context& ctx, const hyperpoint& h) {
+  int which = -1;
+  if(nil) {
+    ld hw = nilv::nilwidth / 2, hw2 = nilv::nilwidth * nilv::nilwidth / 2;
+    ld rz = (abs(h[0]) > abs(h[1]) ? -h[0] * h[1] : 0) + h[2];
+    if(h[0] > hw) which = 3;
+    if(h[0] < -hw) which = 0;
+    if(h[1] > hw) which = 4;
+    if(h[1] < -hw) which = 1;
+    if(rz > hw2) which = 5;
+    if(rz < -hw2) which = 2;
+    }
+  else {
+    ld bw = ctx.binary_width;
+    if(h[0] > bw) which = 0;
+    if(h[0] < -bw) which = 4;
+    if(h[1] > bw) which = 1;
+    if(h[1] < -bw) which = 5;
+    if(h[2] > log(2) / 2) which = h[0] > 0 ? 3 : 2;
+    if(h[2] < -log(2) / 2) which = h[1] > 0 ? 7 : 6;
+    }
+  return which;
+  }
+
+/** the distance from the edge of the face, as computed by map_texture in the shader */
+ld edge_coordinate(int wall, hyperpoint pos) {
+  auto& ws = cgi.wallstart;
+  if(wall + 1 >= isize(ws)) return 1;
+  for(int i=ws[wall]; i<ws[wall+1] && i<ws[wall]+16; i++) {
+    auto& m = cgi.raywall[i];
+    ld x = dot_d(4, m[0], pos), y = dot_d(4, m[1], pos);
+    if(x >= 0 && y >= 0 && x + y <= 1) return x + y;
+    }
+  return 1;
+  }
+
+array<ld, 3> trace(const context& ctx, const hyperpoint& at0) {
+  array<ld, 3> res = {{0, 0, 0}};
+  ld left = 1, go = 0, next = ctx.maxstep;
+  hyperpoint position = ctx.start * C0;
+  hyperpoint tangent = ctx.start * at0;
+  int id = 0;
+
+  for(int iter=0; iter<ctx.max_iter; iter++) {
+    const cell_faces& cf = ctx.md.cells[id];
+    const face *fs = &ctx.md.faces[cf.first];
+    ld dist = 100;
+    int which = -1;
+
+    if(!ctx.stepbased) {
+      for(int i=0; i<cf.sides; i++) {
+        ld d;
+        if(wall_distance(fs[i].ms, position, tangent, d) && d < dist) dist = d, which = i;
+        }
+      if(dist < 0) dist = 0;
+      if(which == -1 && dist == 0) return res;
+      move_along(position, tangent, dist);
+      }
+    else {
+      dist = next < ctx.minstep ? 2 * next : next;
+      hyperpoint nposition = position, vel = tangent * dist;
+      nisot::geodesic_step(nposition, vel);
+      int w = exit_face(ctx, nposition);
+      if(next >= ctx.minstep) {
+        if(w != -1) { next = dist / 2; continue; }
+        if(next < ctx.maxstep) next = next / 2;
+        }
+      else {
+        which = w;
+        next = ctx.maxstep;
+        }
+      position = nposition;
+      tangent = vel / dist;
+      }
+
+    go += dist;
+    if(which == -1) continue;
+
+    const face& f = fs[which];
+    if(f.col[3] > 0) {
+      if(go > ctx.hard_limit) return res;
+      array<ld, 4> col = f.col;
+      hyperpoint pos = position;
+      if(hyperbolic || sphere) pos /= pos[3];
+      if(nil && (which == 2 || which == 5)) pos[2] = 0;
+      ld k = min<ld>(1, (1 - edge_coordinate(f.wall, pos)) / f.edge);
+      ld d = max(1 - go / ctx.sightrange, ctx.exp_start * exp(-go / ctx.exp_decay));
+      for(int a=0; a<3; a++) {
+        col[a] = col[a] * k * d + ctx.fog[a] * (1 - d);
+        if(nil && abs(abs(position[0]) - abs(position[1])) < .005) col[a] /= 2;
+        res[a] += left * col[a] * col[3];
+        }
+      if(col[3] == 1) return res;
+      left *= 1 - col[3];
+      }
+
+    if(f.next < 0) return res;
+    position = f.conn * position;
+    tangent = f.conn * tangent;
+    id = f.next;
+    }
+
+  for(int a=0; a<3; a++) res[a] += left * ctx.fog[a];
+  return res;
+  }
+
+/** render the current view into w*h pixels (0xAARRGGBB, top row first); false if the geometry is not supported */
+EX bool render(int w, int h, vector<color_t>& pixels) {
+  if(!supported()) return false;
+
+  dynamicval<int> dx(vid.xres, w), dy(vid.yres, h);
+  calcparam();
+  auto cd = current_display;
+
+  context ctx;
+
+  /* the starting point, as in ray::cast */
+  cell *cs = centerover;
+  transmatrix T = cview().T;
+  if(nonisotropic) T = NLP * T;
+  T = inverse(T);
+  virtualRebase(cs, T);
+  for(int fixes=0; fixes<100; fixes++) {
+    int a = 0;
+    while(a < cs->type && hdist0(currentmap->ray_iadj(cs, a) * tC0(T)) >= hdist0(tC0(T))) a++;
+    if(a == cs->type) break;
+    T = currentmap->iadj(cs, a) * T;
+    cs = cs->move(a);
+    }
+  ctx.start = T;
+
+  list_cells(ctx.md, cs);
+  prepare_faces(ctx.md);
+
+  ctx.stepbased = is_stepbased();
+  ctx.max_iter = max_iter_current();
+  ctx.maxstep = ctx.stepbased ? maxstep_current() : 0;
+  ctx.minstep = minstep;
+  ctx.sightrange = sightranges[geometry];
+  ctx.exp_start = exp_start;
+  ctx.exp_decay = exp_decay_current();
+  ctx.hard_limit = hard_limit;
+  ctx.binary_width = vid.binary_width / 2 * log(2);
+  color_t fog = darkena(backcolor, 0, 0xFF);
+  for(int a=0; a<3; a++) ctx.fog[a] = part(fog, 3-a) / 255.;
+
+  /* the projection, as in ray::cast (without stereo) */
+  transmatrix proj;
+  if(true) {
+    dynamicval<eGeometry> g(geometry, gCubeTiling);
+    proj = euscale(cd->tanfov, cd->tanfov * cd->ysize / cd->xsize);
+    proj = eupush(-((cd->xcenter-cd->xtop)*2./cd->xsize - 1), -((cd->ycenter-cd->ytop)*2./cd->ysize - 1)) * proj;
+    }
+
+  pixels.resize(w * h);
+  auto do_row = [&] (int y) {
+    for(int x=0; x<w; x++) {
+      hyperpoint at = proj * hyperpoint((x + .5) * 2 / w - 1, 1 - (y + .5) * 2 / h, 1, 1);
+      at[1] = -at[1];
+      at[3] = 0;
+      at /= hypot_d(3, at);
+      auto res = trace(ctx, at);
+      color_t& pix = pixels[y * w + x];
+      pix = 0xFF000000;
+      for(int a=0; a<3; a++)
+        part(pix, 2-a) = (unsigned char) floor(max<ld>(0, min<ld>(1, res[a])) * 255 + .5);
+      }
+    };
+
+  #if CAP_THREAD
+  int qty = threads;
+  if(qty < 0) qty = std::thread::hardware_concurrency();
+  std::atomic<int> next_row(0);
+  auto work = [&] {
+    while(true) {
+      int y = next_row++;
+      if(y >= h) return;
+      do_row(y);
+      }
+    };
+  vector<std::thread> workers;
+  for(int k=1; k<qty; k++) workers.emplace_back(work);
+  work();
+  for(auto& wk: workers) wk.join();
+  #else
+  for(int y=0; y<h; y++) do_row(y);
+  #endif
+
+  return true;
+  }
+
+/** save the pixels as PNG (if the name ends in .png) or binary PPM */
+EX bool save(const string& fname, int w, int h, const vector<color_t>& pixels) {
+  #if CAP_PNG
+  if(isize(fname) > 4 && fname.substr(isize(fname)-4) == ".png") {
+    SDL_PNGStream *png = SDL_PNGStreamOpen(fname.c_str(), w, h, false);
+    if(!png) return false;
+    for(int y=0; y<h; y++) SDL_PNGStreamWriteRow(png, &pixels[y * w]);
+    return SDL_PNGStreamClose(png) == 0;
+    }
+  #endif
+  FILE *f = fopen(fname.c_str(), "wb");
+  if(!f) return false;
+  fprintf(f, "P6\n%d %d\n255\n", w, h);
+  vector<unsigned char> row(3 * w);
+  for(int y=0; y<h; y++) {
+    for(int x=0; x<w; x++) {
+      color_t col = pixels[y * w + x];
+      for(int a=0; a<3; a++) row[3*x+a] = part(col, 2-a);
+      }
+    fwrite(&row[0], 3, w, f);
+    }
+  return fclose(f) == 0;
+  }
+
+#if CAP_RAY && CAP_PNG
+/** render the current view with the shader and on the CPU, and report how much the results differ */
+EX void compare(int w, int h) {
+  vector<color_t> ref, gpu(w * h);
+  if(!render(w, h, ref)) { println(hlog, "CPU raycaster: geometry not supported"); return; }
+  dynamicval<int> dx(vid.xres, w), dy(vid.yres, h);
+  dynamicval<int> dw(want_use, 2);
+  dynamicval<bool> dn(nohud, true);
+  calcparam();
+  shot::render_surface(w, h, shot::default_screenshot_content, [&] (SDL_Surface *s) {
+    for(int y=0; y<h; y++) for(int x=0; x<w; x++) gpu[y * w + x] = qpixel(s, x, y);
+    });
+  int maxdiff = 0, differing = 0;
+  long long total = 0;
+  for(int i=0; i<w*h; i++) {
+    int diff = 0;
+    for(int a=0; a<3; a++) diff = max(diff, abs(part(ref[i], a) - part(gpu[i], a)));
+    maxdiff = max(maxdiff, diff);
+    total += diff;
+    if(diff > 16) differing++;
+    }
+  println(hlog, "CPU raycaster vs shader: max difference ", maxdiff, ", mean ", total * 1. / (w * h), ", ", differing, " of ", w * h, " pixels differ by more than 16");
+  }
+#endif
+
+#if CAP_COMMANDLINE
+int readArgs() {
+  using namespace arg;
+
+  if(0) ;
+  else if(argis("-ray-cpu")) {
+    PHASE(3); start_game();
+    shift(); int w = argi();
+    shift(); int h = argi();
+    shift(); string fname = args();
+    vector<color_t> pixels;
+    if(!render(w, h, pixels))
+      println(hlog, "CPU raycaster: geometry not supported");
+    else if(!save(fname, w, h, pixels))
+      println(hlog, "could not save ", fname);
+    }
+  else if(argis("-ray-cpu-threads")) {
+    shift(); threads = argi();
+    }
+  #if CAP_RAY && CAP_PNG
+  else if(argis("-ray-cpu-check")) {
+    PHASE(3); start_game();
+    shift(); int w = argi();
+    shift(); int h = argi();
+    compare(w, h);
+    }
+  #endif
+  else return 1;
+  return 0;
+  }
+
+auto hook = addHook(hooks_args, 100, readArgs);
+#endif
+
+EX }
+#endif
+
+EX }
+}
@@ -1016,10 +1016,10 @@ void create_matrices() {
   int id = 0;
   while(!dq::drawqueue_c.empty()) {
     auto& p = dq::drawqueue_c.front();
-    cell*& c = p.first;
-    shiftmatrix& V = p.second;
+    cell *c = p.first;
+    shiftmatrix V = p.second;
     current_display->all_drawn_copies[c].push_back(V);
-    gmatrix[p.first] = p.second;
+    gmatrix[c] = V;
     if(id < draw_per_level) {
       auto go = [&] (int i) {
         cell *c1 = c->cmove(i);
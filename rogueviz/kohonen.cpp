@@ -805,8 +805,8 @@ vector<cell*> gen_neuron_cells() {
   else allcells = currentmap->allcells();
   
   if(isize(allcells) > kohrestrict) {
-    map<cell*, int> clindex;
-    for(int i=0; i<isize(allcells); i++) clindex[allcells[i]] = i;
+    ptr_index<cell> clindex;
+    for(int i=0; i<isize(allcells); i++) clindex.insert(allcells[i], i);
     sort(allcells.begin(), allcells.end(), [&clindex] (cell *c1, cell *c2) { 
       ld d1 = hdist0(tC0(ggmatrix(c1)));
       ld d2 = hdist0(tC0(ggmatrix(c2)));
@@ -814,7 +814,7 @@ vector<cell*> gen_neuron_cells() {
         return true;
       if(d2 < d1 - 1e-6)
         return false;
-      return clindex[c1] < clindex[c2];
+      return clindex.find(c1) < clindex.find(c2);
       });
     int at = kohrestrict;
     ld dist = hdist0(tC0(ggmatrix(allcells[at-1])));
@@ -169,3 +169,85 @@ int SDL_SavePNG_RW(SDL_Surface *surface, SDL_RWops *dst, int freedst)
 	if (freedst) SDL_RWclose(dst);
 	return (SUCCESS);
 }
+
+struct SDL_PNGStream {
+	FILE *f;
+	png_structp png_ptr;
+	png_infop info_ptr;
+};
+
+#ifdef __cplusplus
+extern "C"
+#endif
+struct SDL_PNGStream *SDL_PNGStreamOpen(const char *file, int w, int h, int alpha)
+{
+	struct SDL_PNGStream *stream = (struct SDL_PNGStream*) calloc(1, sizeof(struct SDL_PNGStream));
+	if (!stream) return NULL;
+	stream->f = fopen(file, "wb");
+	if (!stream->f)
+	{
+		SDL_SetError("Unable to open %s\n", file);
+		free(stream);
+		return NULL;
+	}
+	stream->png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, png_error_SDL, NULL);
+	if (stream->png_ptr)
+		stream->info_ptr = png_create_info_struct(stream->png_ptr);
+	if (!stream->info_ptr)
+	{
+		SDL_SetError("Unable to create the PNG write structures\n");
+		if (stream->png_ptr) png_destroy_write_struct(&stream->png_ptr, NULL);
+		fclose(stream->f);
+		free(stream);
+		return NULL;
+	}
+	if (setjmp(png_jmpbuf(stream->png_ptr)))
+	{
+		png_destroy_write_struct(&stream->png_ptr, &stream->info_ptr);
+		fclose(stream->f);
+		free(stream);
+		return NULL;
+	}
+
+	png_init_io(stream->png_ptr, stream->f);
+	png_set_IHDR(stream->png_ptr, stream->info_ptr, w, h, 8, alpha ? PNG_COLOR_TYPE_RGB_ALPHA : PNG_COLOR_TYPE_RGB,
+		PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+	png_write_info(stream->png_ptr, stream->info_ptr);
+
+	/* ARGB words are B,G,R,A bytes on little endian and A,R,G,B on big endian */
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+	if (alpha) png_set_swap_alpha(stream->png_ptr);
+	else png_set_filler(stream->png_ptr, 0, PNG_FILLER_BEFORE);
+#else
+	png_set_bgr(stream->png_ptr);
+	if (!alpha) png_set_filler(stream->png_ptr, 0, PNG_FILLER_AFTER);
+#endif
+	return stream;
+}
+
+#ifdef __cplusplus
+extern "C"
+#endif
+int SDL_PNGStreamWriteRow(struct SDL_PNGStream *stream, const void *row)
+{
+	if (setjmp(png_jmpbuf(stream->png_ptr)))
+		return (ERROR);
+	png_write_row(stream->png_ptr, (png_const_bytep) row);
+	return (SUCCESS);
+}
+
+#ifdef __cplusplus
+extern "C"
+#endif
+int SDL_PNGStreamClose(struct SDL_PNGStream *stream)
+{
+	int result = SUCCESS;
+	if (setjmp(png_jmpbuf(stream->png_ptr)))
+		result = ERROR;
+	else
+		png_write_end(stream->png_ptr, stream->info_ptr);
+	png_destroy_write_struct(&stream->png_ptr, &stream->info_ptr);
+	fclose(stream->f);
+	free(stream);
+	return result;
+}
@@ -38,6 +38,22 @@ extern int SDL_SavePNG_RW(SDL_Surface *surface, SDL_RWops *rw, int freedst);
  */
 extern SDL_Surface *SDL_PNGFormatAlpha(SDL_Surface *src);
 
+/*
+ * Write a PNG file row by row, without holding the whole image in memory.
+ *
+ * Each row consists of w 32-bit pixels in the ARGB format (as in the 32-bit
+ * surfaces created by HyperRogue); the alpha byte is ignored unless alpha
+ * is non-zero.
+ *
+ * SDL_PNGStreamOpen returns NULL on failure; the other functions return
+ * 0 on success or -1 on failure. SDL_PNGStreamClose frees the stream
+ * in either case.
+ */
+typedef struct SDL_PNGStream SDL_PNGStream;
+extern SDL_PNGStream *SDL_PNGStreamOpen(const char *file, int w, int h, int alpha);
+extern int SDL_PNGStreamWriteRow(SDL_PNGStream *stream, const void *row);
+extern int SDL_PNGStreamClose(SDL_PNGStream *stream);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -22,10 +22,68 @@ EX always_false in;
 #endif
 
 #if CAP_SVG
+  #if !ISWEB
+  /** buffered output for SVG, written in large blocks, and compressed if the file name ends with .svgz */
+  struct svg_stream : hstream {
+    string buf;
+    FILE *f;
+    #if CAP_ZLIB
+    gzFile gz;
+    #endif
+    long long written, compressed;
+
+    svg_stream() {
+      f = nullptr; written = 0;
+      #if CAP_ZLIB
+      gz = nullptr;
+      #endif
+      }
+
+    bool open(const string& fname) {
+      written = compressed = 0;
+      buf.clear();
+      #if CAP_ZLIB
+      if(isize(fname) > 5 && fname.substr(isize(fname)-5) == ".svgz") {
+        gz = gzopen(fname.c_str(), "wb");
+        return gz;
+        }
+      #endif
+      f = fopen(fname.c_str(), "wt");
+      return f;
+      }
+
+    void write_buffer() {
+      if(buf.empty()) return;
+      written += isize(buf);
+      #if CAP_ZLIB
+      if(gz) gzwrite(gz, buf.c_str(), isize(buf));
+      #endif
+      if(f) fwrite(buf.c_str(), isize(buf), 1, f);
+      buf.clear();
+      }
+
+    void write_char(char c) override { buf += c; if(isize(buf) >= (1<<16)) write_buffer(); }
+    void write_chars(const char* c, size_t q) override { buf.append(c, q); if(isize(buf) >= (1<<16)) write_buffer(); }
+    char read_char() override { throw hstream_exception(); }
+
+    void close() {
+      write_buffer();
+      #if CAP_ZLIB
+      if(gz) {
+        gzflush(gz, Z_FINISH);
+        compressed = gzoffset(gz);
+        gzclose(gz); gz = nullptr;
+        }
+      #endif
+      if(f) fclose(f), f = nullptr;
+      }
+    };
+  #endif
+
   #if ISWEB
   shstream f;
   #else
-  fhstream f;
+  svg_stream f;
   #endif
   
   EX bool in = false;
@@ -46,19 +104,24 @@ EX always_false in;
   int svgsize;
   EX int divby = 10;
   
+  /** val/divby, with 1 or 2 decimal digits if divby > 1; formatted with integer arithmetic,
+   *  since sprintf is the bottleneck for large scenes */
   const char* coord(int val) {
-    static char buf[10][20];
+    static char buf[10][24];
     static int id;
     id++; id %= 10;
-    if(divby == 1) {
-      sprintf(buf[id], "%d", val); return buf[id];
-      }
-    else if(divby <= 10) {
-      sprintf(buf[id], "%.1f", val*1./divby); return buf[id];
-      }
-    else {
-      sprintf(buf[id], "%.2f", val*1./divby); return buf[id];
-      }
+    int digits = divby == 1 ? 0 : divby <= 10 ? 1 : 2;
+    long long scale = digits == 0 ? 1 : digits == 1 ? 10 : 100;
+    long long v = (2 * val * scale + (val >= 0 ? divby : -divby)) / (2 * divby);
+    bool neg = v < 0;
+    if(neg) v = -v;
+    char *p = buf[id] + 23;
+    *p = 0;
+    for(int d=0; d<digits; d++) { *--p = '0' + v % 10; v /= 10; }
+    if(digits) *--p = '.';
+    do { *--p = '0' + v % 10; v /= 10; } while(v);
+    if(neg) *--p = '-';
+    return p;
     }
   
   char* stylestr(color_t fill, color_t stroke, ld width=1) {
@@ -84,7 +147,23 @@ EX always_false in;
     return buf;
     }
   
+  /** consecutive polygons with the same style are merged into a single path:
+   *  0 = never, 1 = only unfilled ones, 2 = all (overlapping filled polygons
+   *  may then produce holes, due to the nonzero fill rule) */
+  EX int merge_paths = 1;
+
+  /** the style of the path which is still open, or "" if none */
+  string open_style;
+
+  void close_path() {
+    if(open_style == "") return;
+    print(f, "\" ", open_style, "/>");
+    println(f);
+    open_style = "";
+    }
+
   EX void circle(int x, int y, int size, color_t col, color_t fillcol, double linewidth) {
+    close_path();
     if(!invisible(col) || !invisible(fillcol)) {
       if(pconf.stretch == 1)
         println(f, "<circle cx='", coord(x), "' cy='", coord(y), "' r='", coord(size), "' ", stylestr(fillcol, col, linewidth), "/>");
@@ -110,6 +189,7 @@ EX always_false in;
   
   EX void text(int x, int y, int size, const string& str, bool frame, color_t col, int align) {
     if(size < min_text) return;
+    close_path();
 
     double dfc = (x - current_display->xcenter) * (x - current_display->xcenter) + 
       (y - current_display->ycenter) * (y - current_display->ycenter);
@@ -155,34 +235,49 @@ EX always_false in;
     if(invisible(col) && invisible(outline)) return;
     if(polyi < 2) return;
 
-    startstring();
+    const char *style = stylestr(col, outline, (hyperbolic ? current_display->radius : current_display->scrsize) * linewidth/256);
+    bool mergeable = link == "" && (merge_paths == 2 || (merge_paths == 1 && invisible(col)));
+
+    if(mergeable && open_style == style)
+      print(f, " ");
+    else {
+      close_path();
+      startstring();
+      print(f, "<path d=\"");
+      }
+
     for(int i=0; i<polyi; i++) {
-      if(i == 0)
-        print(f, "<path d=\"M ");
-      else
-        print(f, " L ");
+      print(f, i ? " L " : "M ");
       print(f, coord(polyx[i]), " ", coord(polyy[i]));
       }
-    
-    print(f, "\" ", stylestr(col, outline, (hyperbolic ? current_display->radius : current_display->scrsize) * linewidth/256), "/>");
-    stopstring();
-    println(f);
+
+    if(mergeable) open_style = style;
+    else {
+      print(f, "\" ", style, "/>");
+      stopstring();
+      println(f);
+      }
     }
   
   EX void render(const string& fname, const function<void()>& what IS(shot::default_screenshot_content)) {
     dynamicval<bool> v2(in, true);
     dynamicval<bool> v3(vid.usingGL, false);
+    auto start = std::chrono::steady_clock::now();
     
     #if ISWEB
     f.s = "";
     #else
-    f.f = fopen(fname.c_str(), "wt");
+    if(!f.open(fname)) {
+      println(hlog, "could not open ", fname);
+      return;
+      }
     #endif
 
     println(f, "<svg xmlns=\"http://www.w3.org/2000/svg\" xmlns:xlink=\"http://www.w3.org/1999/xlink\" width=\"", coord(vid.xres), "\" height=\"", coord(vid.yres), "\">");
     if(!shot::transparent)
       println(f, "<rect width=\"", coord(vid.xres), "\" height=\"", coord(vid.yres), "\" ", stylestr((backcolor << 8) | 0xFF, 0, 0), "/>");
     what();
+    close_path();
     println(f, "</svg>");
     
     #if ISWEB
@@ -193,7 +288,9 @@ EX always_false in;
       x.document.close();
       }, f.s.c_str());
     #else
-    fclose(f.f); f.f = NULL;
+    f.close();
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    println(hlog, "saved ", fname, ": ", format("%lld", f.written), " bytes of SVG", f.compressed ? format(" (%lld compressed)", f.compressed) : "", " in ", int(ms), " ms");
     #endif
     }
 
@@ -227,6 +324,9 @@ int read_args() {
   else if(argis("-svgmt")) {
     shift(); svg::min_text = argi();
     }
+  else if(argis("-svgmerge")) {
+    shift(); svg::merge_paths = argi();
+    }
   else return 1;
   return 0;
   }
@@ -664,6 +764,101 @@ void set_shotx() {
 
 EX int shot_aa = 1;
 
+/** PNG screenshots wider or taller than this are rendered in tiles of tile_size x tile_size
+ *  pixels, and written to the file strip by strip, so neither the framebuffer nor the memory
+ *  needs to hold the whole image (0 = never) */
+EX int tile_size = 0;
+
+/** record_animation hands the frames over to export threads, which compress and
+ *  save them while the next frame is rendered; -1 means one per core, 0 disables this */
+EX int export_threads = -1;
+
+/** how many rendered frames may wait for an export thread */
+EX int export_queue_size = 8;
+
+#if CAP_THREAD
+/** each frame is encoded in parallel, and then committed in the order of frames */
+struct export_pipeline {
+  struct task {
+    int id;
+    reaction_t encode, commit;
+    };
+  std::mutex lock;
+  std::condition_variable cv;
+  std::deque<task> tasks;
+  vector<std::thread> workers;
+  int next_id, next_commit;
+  bool finishing;
+
+  bool active() { return !workers.empty(); }
+
+  void start(int qty) {
+    next_id = next_commit = 0;
+    finishing = false;
+    for(int i=0; i<qty; i++) workers.emplace_back([this] { work(); });
+    }
+
+  void push(reaction_t encode, reaction_t commit) {
+    std::unique_lock<std::mutex> lk(lock);
+    cv.wait(lk, [this] { return isize(tasks) < max(export_queue_size, 1); });
+    tasks.push_back(task{next_id++, encode, commit});
+    cv.notify_all();
+    }
+
+  void work() {
+    while(true) {
+      task t;
+      {
+      std::unique_lock<std::mutex> lk(lock);
+      cv.wait(lk, [this] { return !tasks.empty() || finishing; });
+      if(tasks.empty()) return;
+      t = std::move(tasks.front());
+      tasks.pop_front();
+      cv.notify_all();
+      }
+      if(t.encode) t.encode();
+      std::unique_lock<std::mutex> lk(lock);
+      cv.wait(lk, [this, &t] { return next_commit == t.id; });
+      lk.unlock();
+      if(t.commit) t.commit();
+      lk.lock();
+      next_commit++;
+      cv.notify_all();
+      }
+    }
+
+  void finish() {
+    {
+    std::unique_lock<std::mutex> lk(lock);
+    finishing = true;
+    cv.notify_all();
+    }
+    for(auto& w: workers) w.join();
+    workers.clear();
+    }
+  };
+
+export_pipeline exporter;
+#endif
+
+/** returns true if the export threads have been started by this call (and not before) */
+EX bool start_export() {
+  #if CAP_THREAD
+  if(exporter.active()) return false;
+  int qty = export_threads;
+  if(qty < 0) qty = std::thread::hardware_concurrency();
+  if(qty > 0) { exporter.start(qty); return true; }
+  #endif
+  return false;
+  }
+
+/** wait until all the frames handed to the export threads are saved */
+EX void finish_export() {
+  #if CAP_THREAD
+  if(exporter.active()) exporter.finish();
+  #endif
+  }
+
 EX void default_screenshot_content() {
 
   gamescreen(0);
@@ -683,6 +878,25 @@ EX SDL_Surface *empty_surface(int x, int y, bool alpha) {
 #if CAP_PNG
 
 void output(SDL_Surface* s, const string& fname) {
+  #if CAP_THREAD
+  if(exporter.active()) {
+    SDL_Surface *copy = SDL_ConvertSurface(s, s->format, 0);
+    if(format == screenshot_format::rawfile) {
+      int handle = rawfile_handle, x = shotx, y = shoty;
+      exporter.push(nullptr, [copy, handle, x, y] {
+        for(int iy=0; iy<y; iy++)
+          ignore(write(handle, &qpixel(copy, 0, iy), 4 * x));
+        SDL_FreeSurface(copy);
+        });
+      }
+    else
+      exporter.push([copy, fname] {
+        IMAGESAVE(copy, fname.c_str());
+        SDL_FreeSurface(copy);
+        }, nullptr);
+    return;
+    }
+  #endif
   if(format == screenshot_format::rawfile) {
     for(int y=0; y<shoty; y++)
       ignore(write(rawfile_handle, &qpixel(s, 0, y), 4 * shotx));
@@ -691,11 +905,25 @@ void output(SDL_Surface* s, const string& fname) {
     IMAGESAVE(s, fname.c_str());
   }
 
-EX void postprocess(string fname, SDL_Surface *sdark, SDL_Surface *sbright) {
-  if(gamma == 1 && shot_aa == 1 && sdark == sbright) {
-    output(sdark, fname);
+/** save s (as PNG) and free it; this is done by the export threads if they are running */
+EX void save_and_free(SDL_Surface *s, const string& fname) {
+  #if CAP_THREAD
+  if(exporter.active()) {
+    exporter.push([s, fname] {
+      IMAGESAVE(s, fname.c_str());
+      SDL_FreeSurface(s);
+      }, nullptr);
     return;
     }
+  #endif
+  IMAGESAVE(s, fname.c_str());
+  SDL_FreeSurface(s);
+  }
+
+/** combine the images rendered on dark and bright background (for transparency), and apply
+ *  antialiasing and gamma; returns sdark itself if there is nothing to do */
+SDL_Surface *combine(SDL_Surface *sdark, SDL_Surface *sbright) {
+  if(gamma == 1 && shot_aa == 1 && sdark == sbright) return sdark;
 
   SDL_Surface *sout = empty_surface(shotx, shoty, sdark != sbright);
   for(int y=0; y<shoty; y++)
@@ -723,18 +951,24 @@ EX void postprocess(string fname, SDL_Surface *sdark, SDL_Surface *sbright) {
       part(pix, p) = v;
       }
     }
+  return sout;
+  }
+
+EX void postprocess(string fname, SDL_Surface *sdark, SDL_Surface *sbright) {
+  SDL_Surface *sout = combine(sdark, sbright);
   output(sout, fname);
-  SDL_FreeSurface(sout);
+  if(sout != sdark) SDL_FreeSurface(sout);
   }
 #endif
 
 EX purehookset hooks_take;
 
 #if CAP_PNG
-void render_png(string fname, const function<void()>& what) {
+/** render what() into a x*y buffer, and call f on the postprocessed result */
+EX void render_surface(int x, int y, const function<void()>& what, const function<void(SDL_Surface*)>& f) {
   resetbuffer rb;
 
-  renderbuffer glbuf(vid.xres, vid.yres, vid.usingGL);
+  renderbuffer glbuf(x, y, vid.usingGL);
   glbuf.enable();
   current_display->set_viewport(0);
 
@@ -747,20 +981,80 @@ void render_png(string fname, const function<void()>& what) {
   
   SDL_Surface *sdark = glbuf.render();
 
+  SDL_Surface *sbright = sdark;
+  unique_ptr<renderbuffer> glbuf1;
+
   if(transparent) {
-    renderbuffer glbuf1(vid.xres, vid.yres, vid.usingGL);
+    glbuf1 = unique_ptr<renderbuffer>(new renderbuffer(x, y, vid.usingGL));
     backcolor = 0xFFFFFFFF;
     #if CAP_RUG
     if(rug::rugged && !rug::renderonce) rug::prepareTexture();
     #endif
-    glbuf1.enable();
-    glbuf1.clear(backcolor);
+    glbuf1->enable();
+    glbuf1->clear(backcolor);
     current_display->set_viewport(0);
     what();
-    
-    postprocess(fname, sdark, glbuf1.render());
+    sbright = glbuf1->render();
+    }
+
+  SDL_Surface *sout = combine(sdark, sbright);
+  f(sout);
+  if(sout != sdark) SDL_FreeSurface(sout);
+  }
+
+void render_png(string fname, const function<void()>& what) {
+  render_surface(vid.xres, vid.yres, what, [&] (SDL_Surface *s) { output(s, fname); });
+  }
+
+/** while rendering a tile, calcparam moves the view by (-tile_x, -tile_y) rendered pixels */
+bool in_tile;
+int tile_x, tile_y;
+
+auto tile_hook = addHook(hooks_calcparam, 100, [] {
+  if(!in_tile) return;
+  auto cd = current_display;
+  cd->xcenter -= tile_x;
+  cd->ycenter -= tile_y;
+  cd->xtop = cd->ytop = 0;
+  cd->xsize = cd->ysize = tile_size * shot_aa;
+  });
+
+EX bool use_tiles() {
+  return tile_size > 0 && (shotx > tile_size || shoty > tile_size) && GDIM == 2 && !current_display->stereo_active();
+  }
+
+/** vid.xres and vid.yres stay at the size of the whole image, so that the models
+ *  (and the limits on polygon sizes in drawing.cpp) work exactly as without tiles */
+void render_png_tiled(string fname, const function<void()>& what) {
+  int full_x = shotx, full_y = shoty;
+  int ts = tile_size;
+  SDL_PNGStream *png = SDL_PNGStreamOpen(fname.c_str(), full_x, full_y, transparent);
+  if(!png) {
+    println(hlog, "could not open ", fname);
+    return;
+    }
+
+  vector<color_t> strip(full_x * ts);
+  dynamicval<int> dx(shotx, ts), dy(shoty, ts);
+  dynamicval<bool> dt(in_tile, true);
+  dynamicval<bool> dn(nohud, true);
+
+  for(int y0=0; y0<full_y; y0+=ts) {
+    for(int x0=0; x0<full_x; x0+=ts) {
+      tile_x = x0 * shot_aa;
+      tile_y = y0 * shot_aa;
+      calcparam();
+      render_surface(ts * shot_aa, ts * shot_aa, what, [&] (SDL_Surface *s) {
+        for(int y=0; y<ts && y0+y<full_y; y++)
+        for(int x=0; x<ts && x0+x<full_x; x++)
+          strip[y * full_x + x0 + x] = qpixel(s, x, y);
+        });
+      }
+    for(int y=0; y<ts && y0+y<full_y; y++)
+      SDL_PNGStreamWriteRow(png, &strip[y * full_x]);
     }
-  else postprocess(fname, sdark, sdark);
+
+  if(SDL_PNGStreamClose(png)) println(hlog, "error writing ", fname);
   }
 #endif
 
@@ -814,7 +1108,10 @@ EX void take(string fname, const function<void()>& what IS(default_screenshot_co
     case screenshot_format::png:
     case screenshot_format::rawfile:
       #if CAP_PNG
-      render_png(fname, what);
+      if(format == screenshot_format::png && use_tiles())
+        render_png_tiled(fname, what);
+      else
+        render_png(fname, what);
       #endif
       break;
     }
@@ -834,6 +1131,9 @@ int png_read_args() {
   else if(argis("-pngsize")) {
     shift(); shoty = argi(); if(shotformat == -1) shotformat = 0;
     }
+  else if(argis("-pngtiles")) {
+    shift(); tile_size = argi();
+    }
   else if(argis("-pngformat")) {
     shift(); shotformat = argi();
     }
@@ -1386,6 +1686,8 @@ EX bool record_animation_of(reaction_t content) {
   lastticks = 0;
   ticks = 0;
   int oldturn = -1;
+  bool exporting = shot::start_export();
+  finalizer f([exporting] { if(exporting) shot::finish_export(); });
   for(int i=0; i<noframes; i++) {
     if(i < min_frame || i > max_frame) continue;
     printf("%d/%d\n", i, noframes);
@@ -1742,6 +2044,9 @@ int readArgs() {
     PHASE(3); shift(); noframes = argi();
     shift(); animfile = args(); record_animation();
     }
+  else if(argis("-animthreads")) {
+    PHASEFROM(2); shift(); shot::export_threads = argi();
+    }
   else if(argis("-record-only")) {
     PHASEFROM(2); 
     shift(); min_frame = argi();
@@ -18,8 +18,9 @@ constexpr flagtype GF_VARCOLOR = 2;
 constexpr flagtype GF_LIGHTFOG = 4;
 constexpr flagtype GF_LEVELS   = 8;
 constexpr flagtype GF_TEXTURE_SHADED  = 16;
+constexpr flagtype GF_INSTANCED = 32;
 
-constexpr flagtype GF_which    = 31;
+constexpr flagtype GF_which    = 63;
 
 constexpr flagtype SF_PERS3        = 256;
 constexpr flagtype SF_BAND         = 512;
@@ -41,6 +42,8 @@ EX bool solv_all;
 constexpr int aPosition = 0;
 constexpr int aColor = 3;
 constexpr int aTexture = 8;
+/** per-instance model matrix for instanced drawing; a mat4 takes four locations, 4..7 */
+constexpr int aInstance = 4;
 
 /* texture bindings */
 constexpr int INVERSE_EXP_BINDING = 2;
@@ -136,6 +139,9 @@ shared_ptr<glhr::GLprogram> write_shader(flagtype shader_flags) {
     have_vfogs = true;
     }
 
+  if(shader_flags & GF_INSTANCED)
+    vsh += "attribute mediump mat4 aInstance;\n";
+
   string coordinator;
   string distfun;
   bool treset = false;
@@ -454,6 +460,13 @@ shared_ptr<glhr::GLprogram> write_shader(flagtype shader_flags) {
 
   vmain += "}";
   fmain += "}";
+
+  /* with instancing, uMV holds only the common part, and the model matrix comes per instance */
+  if(shader_flags & GF_INSTANCED) {
+    string mv = "uMV * ", imv = "uMV * aInstance * ";
+    for(size_t pos = vmain.find(mv); pos != string::npos; pos = vmain.find(mv, pos + imv.size()))
+      vmain.replace(pos, mv.size(), imv);
+    }
   
   fsh += varying;
   fsh += fmain;
@@ -777,16 +790,8 @@ EX flagtype get_shader_flags() {
   return glhr::current_glprogram->shader_flags;
   }
 
-EX void glapplymatrix(const transmatrix& V) {
-  #if CAP_VR
-  transmatrix V3;
-  bool use_vr = vrhr::rendering();
-  if(use_vr) V3 = vrhr::hmd_pre * V;
-  const transmatrix& V2 = use_vr ? V3 : V;
-  #else
-  const transmatrix& V2 = V;
-  #endif
-  GLfloat mat[16];
+/** write V into mat in the layout expected by uMV (and by the per-instance aInstance) */
+EX void matrix_to_gl(const transmatrix& V2, GLfloat *mat) {
   int id = 0;
   
   if(MXDIM == 3) {
@@ -803,6 +808,19 @@ EX void glapplymatrix(const transmatrix& V) {
     for(int y=0; y<4; y++) 
       for(int x=0; x<4; x++) mat[id++] = V2[x][y];
     }
+  }
+
+EX void glapplymatrix(const transmatrix& V) {
+  #if CAP_VR
+  transmatrix V3;
+  bool use_vr = vrhr::rendering();
+  if(use_vr) V3 = vrhr::hmd_pre * V;
+  const transmatrix& V2 = use_vr ? V3 : V;
+  #else
+  const transmatrix& V2 = V;
+  #endif
+  GLfloat mat[16];
+  matrix_to_gl(V2, mat);
   glhr::set_modelview(glhr::as_glmatrix(mat));
   }
 
@@ -0,0 +1,265 @@
+// Hyperbolic Rogue -- disk cache for shapes
+// Copyright (C) 2011-2019 Zeno Rogue, see 'hyper.cpp' for details
+
+/** \file shapecache.cpp
+ *  \brief Saving the shape sets computed by geometry_information::prepare_shapes to disk, and loading them instead of recomputing.
+ *
+ *  The cache is enabled with `-shape-cache <directory>`. Every shape set is stored in a separate file, named after
+ *  a hash of its key (cgi_string() and a few other settings which affect prepare_shapes). The full key is also
+ *  stored in the file and checked when loading, so a hash collision or a file from another version just causes
+ *  the shapes to be recomputed (and the file to be overwritten).
+ */
+
+#include "hyper.h"
+
+namespace hr {
+
+#if CAP_SHAPECACHE
+EX namespace shapecache {
+
+/** the directory where the shape sets are cached; empty = do not use the cache */
+EX string dir;
+
+static const int format_version = 1;
+
+template<class T> void sync(hstream& hs, bool saving, T& x) { if(saving) hwrite(hs, x); else hread(hs, x); }
+template<class T, class... U> void sync(hstream& hs, bool saving, T& x, U&... y) { sync(hs, saving, x); sync(hs, saving, y...); }
+
+template<class T> void sync_raw(hstream& hs, bool saving, T& x) {
+  if(saving) hs.write_chars((char*) &x, sizeof(T));
+  else hs.read_chars((char*) &x, sizeof(T));
+  }
+
+/** vectors of plain data are stored as one block */
+template<class T> void sync_raw(hstream& hs, bool saving, vector<T>& v) {
+  int n = isize(v);
+  sync(hs, saving, n);
+  if(n < 0) throw hstream_exception();
+  if(!saving) v.resize(n);
+  if(n == 0) return;
+  if(saving) hs.write_chars((char*) &v[0], sizeof(T) * n);
+  else hs.read_chars((char*) &v[0], sizeof(T) * n);
+  }
+
+template<class T> void sync_size(hstream& hs, bool saving, vector<T>& v) {
+  int n = isize(v);
+  sync(hs, saving, n);
+  if(n < 0) throw hstream_exception();
+  if(!saving) v.resize(n);
+  }
+
+/** the key of the shape set prepare_shapes would compute now */
+EX string key() {
+  string s = cgi_string();
+  s += "FSL: " + its(floorshapes_level) + "; ";
+  s += "GUI: " + its(!noGUI) + "; ";
+  #if CAP_GL
+  s += "FT: " + its(floor_textures ? 1 : 0) + "; ";
+  #endif
+  return s;
+  }
+
+EX string filename(const string& key) {
+  char buf[32];
+  snprintf(buf, 32, "%016llx", (unsigned long long) std::hash<string>()(key));
+  return dir + "/shapes-" + buf + ".dat";
+  }
+
+string header() {
+  return "HyperRogue " VER " shapes " + its(format_version) + " " + its(int(sizeof(hyperpoint))) + " " + its(int(sizeof(glvertex)));
+  }
+
+int tinf_code(geometry_information& gi, basic_textureinfo *t) {
+  if(!t) return -1;
+  if(t == &gi.models_texture) return -2;
+  int q = isize(floor_texture_vertices);
+  if(q && t >= &floor_texture_vertices[0] && t < &floor_texture_vertices[0] + q) return int(t - &floor_texture_vertices[0]);
+  throw hstream_exception();
+  }
+
+basic_textureinfo *tinf_of_code(geometry_information& gi, int code) {
+  if(code == -1) return nullptr;
+  if(code == -2) return &gi.models_texture;
+  if(code < 0 || code >= isize(floor_texture_vertices)) throw hstream_exception();
+  return &floor_texture_vertices[code];
+  }
+
+/** load the shape set for key into gi; returns false if it is not in the cache */
+EX bool load(geometry_information& gi, const string& key) {
+  fhstream f(filename(key), "rb");
+  if(!f.f) return false;
+  try {
+    string h, k;
+    hread(f, h);
+    if(h != header()) return false;
+    hread(f, k);
+    if(k != key) return false;
+    gi.serialize_shapes(f, false);
+    }
+  catch(hstream_exception& e) {
+    println(hlog, "shape cache: could not read ", filename(key));
+    gi.clear_shapes();
+    return false;
+    }
+  return true;
+  }
+
+/** save the shape set of gi, just computed by prepare_shapes, under key */
+EX void save(geometry_information& gi, const string& key) {
+  string fname = filename(key);
+  string tmpname = fname + ".tmp";
+  bool ok = true;
+  if(1) {
+    fhstream f(tmpname, "wb");
+    if(!f.f) return;
+    try {
+      hwrite(f, header());
+      hwrite(f, key);
+      gi.serialize_shapes(f, true);
+      }
+    catch(hstream_exception& e) { ok = false; }
+    }
+  if(ok) ok = rename(tmpname.c_str(), fname.c_str()) == 0;
+  if(!ok) {
+    println(hlog, "shape cache: could not write ", fname);
+    remove(tmpname.c_str());
+    }
+  }
+
+#if CAP_COMMANDLINE
+int readArgs() {
+  using namespace arg;
+
+  if(0) ;
+  else if(argis("-shape-cache")) {
+    shift(); dir = args();
+    }
+  else return 1;
+  return 0;
+  }
+
+auto hook = addHook(hooks_args, 100, readArgs);
+#endif
+
+EX }
+
+void for_each_shape(floorshape& fsh, const function<void(hpcshape&)>& f) {
+  for(auto& sh: fsh.b) f(sh);
+  for(auto& sh: fsh.shadow) f(sh);
+  for(int k=0; k<SIDEPARS; k++) {
+    for(auto& sh: fsh.side[k]) f(sh);
+    for(auto& sh: fsh.levels[k]) f(sh);
+    for(auto& v: fsh.gpside[k]) for(auto& sh: v) f(sh);
+    }
+  for(int c=0; c<2; c++) for(auto& sh: fsh.cone[c]) f(sh);
+  }
+
+void geometry_information::for_each_shape(const function<void(hpcshape&)>& f) {
+  /* the hpcshape members from shSemiFloorSide to shReserved are declared one after another */
+  for(hpcshape *sh = &shSemiFloorSide[0]; sh != shReserved + 16; sh++) f(*sh);
+  for(auto& sh: shFullCross) f(sh);
+  for(auto v: {&shPlainWall3D, &shWireframe3D, &shWall3D, &shMiniWall3D}) for(auto& sh: *v) f(sh);
+  for(auto fsh: all_plain_floorshapes) hr::for_each_shape(*fsh, f);
+  for(auto fsh: all_escher_floorshapes) hr::for_each_shape(*fsh, f);
+  }
+
+void geometry_information::clear_shapes() {
+  hpc.clear();
+  allshapes.clear();
+  symmetriesAt.clear();
+  for(auto v: {&shPlainWall3D, &shWireframe3D, &shWall3D, &shMiniWall3D}) v->clear();
+  walltester.clear();
+  walloffsets.clear();
+  wallstart.clear();
+  raywall.clear();
+  models_texture.tvertices.clear();
+  models_texture.colors.clear();
+  for(auto fsh: all_plain_floorshapes) *(floorshape*)fsh = floorshape();
+  for(auto fsh: all_escher_floorshapes) *(floorshape*)fsh = floorshape();
+  }
+
+void geometry_information::serialize_shapes(hstream& hs, bool saving) {
+  using namespace shapecache;
+  if(!saving) init_floorshapes();
+
+  sync(hs, saving, SD3, SD6, SD7, S12, S14, S21, S28, S42, S36, S84);
+  sync(hs, saving, sword_size, orb_inner_ring, corner_bonus, wormscale, tentacle_length);
+  for(auto& a: asteroid_size) sync(hs, saving, a);
+  for(int k=0; k<SIDEPARS; k++) sync(hs, saving, dlow_table[k], dhi_table[k], dfloor_table[k], validsidepar[k]);
+  sync_raw(hs, saving, shadowmulmatrix);
+
+  sync_raw(hs, saving, hpc);
+  sync(hs, saving, prehpc);
+  sync_raw(hs, saving, symmetriesAt);
+  sync_raw(hs, saving, walltester);
+  sync_raw(hs, saving, wallstart);
+  sync_raw(hs, saving, raywall);
+  sync_raw(hs, saving, models_texture.tvertices);
+  sync_raw(hs, saving, models_texture.colors);
+
+  /* the cells in walloffsets are only set later */
+  vector<int> wo;
+  if(saving) for(auto& p: walloffsets) {
+    if(p.second) throw hstream_exception();
+    wo.push_back(p.first);
+    }
+  sync_raw(hs, saving, wo);
+  if(!saving) {
+    walloffsets.clear();
+    for(int i: wo) walloffsets.emplace_back(i, nullptr);
+    }
+
+  /* the sizes of the shape vectors first, so that for_each_shape lists the same shapes */
+  for(auto v: {&shPlainWall3D, &shWireframe3D, &shWall3D, &shMiniWall3D}) sync_size(hs, saving, *v);
+  auto floor_sizes = [&] (floorshape& fsh) {
+    sync(hs, saving, fsh.prio, fsh.pstrength, fsh.fstrength);
+    sync_size(hs, saving, fsh.b);
+    sync_size(hs, saving, fsh.shadow);
+    for(int k=0; k<SIDEPARS; k++) {
+      sync_size(hs, saving, fsh.side[k]);
+      sync_size(hs, saving, fsh.levels[k]);
+      sync_size(hs, saving, fsh.gpside[k]);
+      for(auto& v: fsh.gpside[k]) sync_size(hs, saving, v);
+      }
+    for(int c=0; c<2; c++) sync_size(hs, saving, fsh.cone[c]);
+    };
+  for(auto fsh: all_plain_floorshapes) floor_sizes(*fsh), sync(hs, saving, fsh->rad0, fsh->rad1);
+  for(auto fsh: all_escher_floorshapes) floor_sizes(*fsh), sync(hs, saving, fsh->scale);
+
+  map<hpcshape*, int> ids;
+  vector<hpcshape*> shapes;
+  for_each_shape([&] (hpcshape& sh) {
+    ids[&sh] = isize(shapes);
+    shapes.push_back(&sh);
+    int tinf = saving ? tinf_code(*this, sh.tinf) : 0;
+    sync(hs, saving, sh.s, sh.e, sh.prio, sh.flags, sh.texture_offset, sh.shs, sh.she, tinf);
+    sync_raw(hs, saving, sh.intester);
+    if(!saving) sh.tinf = tinf_of_code(*this, tinf);
+    });
+
+  /* allshapes may also contain stale pointers into floorshape vectors which have been reallocated since; these are skipped */
+  vector<int> all;
+  if(saving) for(auto sh: allshapes) if(ids.count(sh)) all.push_back(ids[sh]);
+  sync_raw(hs, saving, all);
+
+  if(saving) return;
+
+  allshapes.clear();
+  for(int i: all) {
+    if(i < 0 || i >= isize(shapes)) throw hstream_exception();
+    allshapes.push_back(shapes[i]);
+    }
+  for(auto sh: shapes) if(sh->e > isize(hpc) || sh->s > sh->e) throw hstream_exception();
+
+  last = nullptr;
+  shPipe.clear();
+  #if CAP_GL
+  if(floor_textures) models_texture.texture_id = floor_textures->renderedTexture;
+  #endif
+  /* prepare_shapes has made sure that the floor textures have enough vertices for these */
+  for(auto sh: shapes) if(sh->tinf && sh->tinf != &models_texture) ensure_vertex_number(*sh);
+  initPolyForGL();
+  }
+
+#endif
+}
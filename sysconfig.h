@@ -109,6 +109,10 @@
 #define CAP_NOSHADER (!ISMOBILE && !ISWEB)
 #endif
 
+#ifndef CAP_INSTANCING
+#define CAP_INSTANCING (CAP_SHADER && !ISMOBWEB && !ISMAC)
+#endif
+
 #ifndef CAP_ANIMATIONS
 #define CAP_ANIMATIONS (!ISMINI)
 #endif
@@ -117,6 +121,10 @@
 #define CAP_FILES (!ISMINI)
 #endif
 
+#ifndef CAP_MMAP
+#define CAP_MMAP (CAP_FILES && !ISWINDOWS && !ISMOBWEB)
+#endif
+
 #ifndef CAP_INV
 #define CAP_INV (!ISMINI)
 #endif
@@ -205,6 +213,25 @@
 #define CAP_MDIM_FIXED 0
 #endif
 
+/** allocate cells and heptagons from slabs (see slab_arena) */
+#ifndef CAP_SLAB
+#define CAP_SLAB 1
+#endif
+
+/** keep a structure-of-arrays copy of the path distances of the cells in dcal (see hot::build) */
+#ifndef CAP_HOTCELLS
+#define CAP_HOTCELLS 1
+#endif
+
+/** use SSE2/AVX kernels for 4x4 matrix computations (requires ld == double) */
+#ifndef CAP_SIMD
+#if defined(__SSE2__) && MAXMDIM == 4
+#define CAP_SIMD 1
+#else
+#define CAP_SIMD 0
+#endif
+#endif
+
 #ifndef CAP_TEXTURE
 #define CAP_TEXTURE (CAP_GL && (CAP_PNG || CAP_SDL_IMG) && !ISMINI)
 #endif
@@ -277,6 +304,10 @@
 #define CAP_SHAPES 1
 #endif
 
+#ifndef CAP_SHAPECACHE
+#define CAP_SHAPECACHE (CAP_SHAPES && CAP_FILES && !ISMOBWEB)
+#endif
+
 #define CAP_QUEUE CAP_POLY
 #define CAP_CURVE CAP_POLY
 
@@ -518,6 +549,7 @@ typedef unsigned GLuint;
 #include <array>
 #include <set>
 #include <random>
+#include <chrono>
 #include <complex>
 #include <new>
 #include <limits.h>
@@ -557,12 +589,18 @@ typedef unsigned GLuint;
 #include <mutex>
 #include <condition_variable>
 #endif
+#include <atomic>
 #endif
 
 #include <stdint.h>
 
+#if CAP_SIMD
+#include <immintrin.h>
+#endif
+
 #if ISWINDOWS
 #include "direntx.h"
+#include <malloc.h>
 #else
 #include <dirent.h>
 #endif
@@ -581,6 +619,11 @@ typedef unsigned GLuint;
 #include <sys/stat.h>
 #endif
 
+#if CAP_MMAP
+#include <sys/mman.h>
+#include <fcntl.h>
+#endif
+
 #if CAP_TIMEOFDAY
 #include <sys/time.h>
 #endif
@@ -649,6 +692,10 @@ union SDL_Event;
 #define CAP_RAY (MAXMDIM >= 4 && CAP_GL && !ISMOBILE && !ISWEB)
 #endif
 
+#ifndef CAP_RAYCPU
+#define CAP_RAYCPU (MAXMDIM >= 4 && !ISMOBILE && !ISWEB)
+#endif
+
 #ifndef CAP_MEMORY_RESERVE
 #define CAP_MEMORY_RESERVE (!ISMOBILE && !ISWEB)
 #endif
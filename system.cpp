@@ -1681,6 +1681,11 @@ EX void finishAll() {
 auto cgm = addHook(hooks_clearmemory, 40, [] () {
   pathq.clear();
   dcal.clear();
+  #if CAP_HOTCELLS
+  hot::forget();
+  #endif
+  pathcache::forget();
+  dq::forget_relative();
   clearshadow();
   for(int i=0; i<MAXPLAYER; i++) lastmountpos[i] = NULL;
   seenSevenMines = false;
@@ -1695,6 +1700,18 @@ auto cgm = addHook(hooks_clearmemory, 40, [] () {
 addHook(hooks_gamedata, 0, [] (gamedata* gd) {
   gd->store(pathq);
   gd->store(dcal);
+  #if CAP_HOTCELLS
+  gd->store(hot::cells);
+  gd->store(hot::pathdist);
+  gd->store(hot::adj_start);
+  gd->store(hot::adj);
+  gd->store(hot::row_size);
+  gd->store(hot::free_slots);
+  gd->store(hot::live_adj);
+  gd->store(hot::unlinked);
+  #endif
+  gd->store(pathcache::fields);
+  gd->store(pathcache::fields_epoch);
   gd->store(recallCell);
   gd->store(butterflies);
   gd->store(buggycells);
@@ -1722,5 +1739,10 @@ addHook(hooks_removecells, 0, [] () {
   vector<cell*> to_remove;
   for(auto p: rosemap) if(is_cell_removed(p.first)) to_remove.push_back(p.first);
   for(auto r: to_remove) rosemap.erase(r);
+  #if CAP_HOTCELLS
+  hot::forget();
+  #endif
+  pathcache::forget();
+  dq::forget_relative();
   });
 }